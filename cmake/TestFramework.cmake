@@ -61,3 +61,45 @@ function(add_gtest)
 
 endfunction()
 
+
+# Use this target to build all benchmarks you added
+add_custom_target(
+  build_all_benchmarks
+)
+
+# Use this target to build and run all benchmarks you added
+add_custom_target(
+  run_all_benchmarks
+)
+
+function(add_benchmark)
+  set(one_value_args NAME)
+  set(multi_value_args SOURCES LIBS ARGS)
+  cmake_parse_arguments(BENCHMARK "" "${one_value_args}" "${multi_value_args}" ${ARGN})
+
+  message("-- Added benchmark: ${BENCHMARK_NAME}")
+
+  add_executable(${BENCHMARK_NAME} ${BENCHMARK_SOURCES})
+  target_link_libraries(${BENCHMARK_NAME} PRIVATE ${BENCHMARK_LIBS})
+  # numbers of unoptimized build are meaningless, so benchmarks are optimized in any build type
+  target_compile_options(${BENCHMARK_NAME} PRIVATE -O2)
+  # benchmarks are not part of the default build, they are built by build_all_benchmarks
+  set_target_properties(${BENCHMARK_NAME} PROPERTIES EXCLUDE_FROM_ALL TRUE)
+
+  add_custom_target(
+    ${BENCHMARK_NAME}_run
+    COMMAND ${CMAKE_RUNTIME_OUTPUT_DIRECTORY}/${BENCHMARK_NAME} ${BENCHMARK_ARGS}
+    DEPENDS ${BENCHMARK_NAME}
+  )
+
+  add_dependencies(
+    build_all_benchmarks
+    ${BENCHMARK_NAME}
+  )
+
+  add_dependencies(
+    run_all_benchmarks
+    ${BENCHMARK_NAME}_run
+  )
+
+endfunction()
@@ -0,0 +1,362 @@
+/**
+ * Throughput and latency of Allocate/Free for the project allocators and glibc malloc.
+ * Every synthetic pattern is a trace, so recorded traces (--trace <file>, text or binary format) are replayed by
+ * the same code.
+ * Usage: allocator_benchmark [--ops <count>] [--trace <file>]...
+ */
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "memory_management/allocator_benchmarks/include/allocation_trace.h"
+#include "memory_management/allocator_benchmarks/include/allocator_adapters.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t DEFAULT_OPS = 200000U;
+constexpr size_t MAX_BENCHMARK_SIZE = 4096U;
+// Synthetic patterns
+
+AllocationTrace MakeLifoTrace(size_t ops)
+{
+    constexpr size_t DEPTH = 1000U;
+    AllocationTrace trace("lifo");
+    std::mt19937 gen(1U);
+    std::vector<uint32_t> stack;
+    while (trace.GetEvents().size() < ops) {
+        for (size_t i = 0; i < DEPTH; i++) {
+            stack.push_back(trace.Allocate(16U + gen() % 112U));
+        }
+        for (; !stack.empty(); stack.pop_back()) {
+            trace.Free(stack.back());
+        }
+    }
+    return trace;
+}
+
+AllocationTrace MakeFifoTrace(size_t ops)
+{
+    constexpr size_t WINDOW = 1000U;
+    AllocationTrace trace("fifo");
+    std::mt19937 gen(2U);
+    std::vector<uint32_t> queue;
+    size_t head = 0;
+    while (trace.GetEvents().size() < ops) {
+        queue.push_back(trace.Allocate(16U + gen() % 112U));
+        if (queue.size() - head > WINDOW) {
+            trace.Free(queue[head++]);
+        }
+    }
+    for (; head < queue.size(); head++) {
+        trace.Free(queue[head]);
+    }
+    return trace;
+}
+
+/// Random interleaving of allocations and frees with sizes from @param sizeOf
+template <class SizeGenerator>
+AllocationTrace MakeRandomTrace(const char *name, size_t ops, uint32_t seed, SizeGenerator sizeOf)
+{
+    constexpr size_t MAX_LIVE = 4096U;
+    AllocationTrace trace(name);
+    std::mt19937 gen(seed);
+    std::vector<uint32_t> live;
+    while (trace.GetEvents().size() < ops) {
+        bool allocate = live.empty() || (live.size() < MAX_LIVE && gen() % 2U == 0);
+        if (allocate) {
+            live.push_back(trace.Allocate(sizeOf(gen)));
+        } else {
+            size_t victim = gen() % live.size();
+            trace.Free(live[victim]);
+            live[victim] = live.back();
+            live.pop_back();
+        }
+    }
+    for (uint32_t slot : live) {
+        trace.Free(slot);
+    }
+    return trace;
+}
+
+AllocationTrace MakeUniformRandomTrace(size_t ops)
+{
+    return MakeRandomTrace("random", ops, 3U, [](std::mt19937 &gen) { return uint32_t(16U + gen() % 496U); });
+}
+
+/// Mostly small objects with a tail of large buffers, like typical service heap
+AllocationTrace MakeSizeMixedTrace(size_t ops)
+{
+    return MakeRandomTrace("size_mixed", ops, 4U, [](std::mt19937 &gen) {
+        uint32_t kind = gen() % 100U;
+        if (kind < 70U) {
+            return uint32_t(8U + gen() % 56U);
+        }
+        if (kind < 95U) {
+            return uint32_t(64U + gen() % 448U);
+        }
+        return uint32_t(512U + gen() % (MAX_BENCHMARK_SIZE - 512U));
+    });
+}
+
+/**
+ * Request handling service: per request buffer, headers and parsed nodes are freed when the request ends, a small
+ * part of objects goes to a long living cache which evicts the oldest entry
+ */
+AllocationTrace MakeRequestHandlingTrace(size_t ops)
+{
+    constexpr size_t CACHE_CAPACITY = 256U;
+    constexpr uint32_t BUFFER_SIZE = 4096U;
+    constexpr std::array<uint32_t, 6U> NODE_SIZES = {24U, 40U, 56U, 72U, 96U, 128U};
+    AllocationTrace trace("request_handling");
+    std::mt19937 gen(6U);
+    std::deque<uint32_t> cache;
+    std::vector<uint32_t> request;
+    while (trace.GetEvents().size() < ops) {
+        request.push_back(trace.Allocate(BUFFER_SIZE));
+        size_t nodes = 8U + gen() % 32U;
+        for (size_t i = 0; i < nodes; i++) {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+            uint32_t size = gen() % 10U == 0 ? 128U + gen() % 1920U : NODE_SIZES[gen() % NODE_SIZES.size()];
+            uint32_t slot = trace.Allocate(size);
+            if (gen() % 16U != 0) {
+                request.push_back(slot);
+                continue;
+            }
+            cache.push_back(slot);
+            if (cache.size() > CACHE_CAPACITY) {
+                trace.Free(cache.front());
+                cache.pop_front();
+            }
+        }
+        for (; !request.empty(); request.pop_back()) {
+            trace.Free(request.back());
+        }
+    }
+    for (uint32_t slot : cache) {
+        trace.Free(slot);
+    }
+    return trace;
+}
+
+// Measurement
+
+struct Result {
+    bool failed {false};
+    double opsPerSecond {0};
+    std::vector<uint64_t> latencies;  // ns of every operation of one replay
+};
+
+template <class Adapter>
+bool ReplayOnce(Adapter *adapter, const AllocationTrace &trace, std::vector<void *> *live, uint64_t *latencies)
+{
+    bool ok = true;
+    for (const TraceEvent &event : trace.GetEvents()) {
+        Clock::time_point start;
+        if (latencies != nullptr) {
+            start = Clock::now();
+        }
+        void *&slot = (*live)[event.slot];
+        if (event.op == TraceOp::ALLOCATE) {
+            slot = adapter->Allocate(event.size);
+            if (slot == nullptr) {
+                ok = false;
+                break;
+            }
+            // memory is touched like a real user would do
+            *static_cast<volatile uint8_t *>(slot) = 1U;
+        } else {
+            adapter->Free(slot);
+            slot = nullptr;
+        }
+        if (latencies != nullptr) {
+            *latencies++ = static_cast<uint64_t>(std::chrono::nanoseconds(Clock::now() - start).count());
+        }
+    }
+    // recorded traces can leave allocations alive
+    for (void *&ptr : *live) {
+        if (ptr != nullptr) {
+            adapter->Free(ptr);
+            ptr = nullptr;
+        }
+    }
+    adapter->Reset();
+    return ok;
+}
+
+template <class Adapter>
+Result RunTrace(const AllocationTrace &trace)
+{
+    constexpr size_t REPEATS = 5U;
+    Result result;
+    auto adapter = std::make_unique<Adapter>();
+    std::vector<void *> live(trace.GetSlotsCount(), nullptr);
+    // warm up, so the allocator has its pools mapped
+    if (!ReplayOnce(adapter.get(), trace, &live, nullptr)) {
+        result.failed = true;
+        return result;
+    }
+    auto start = Clock::now();
+    for (size_t i = 0; i < REPEATS; i++) {
+        ReplayOnce(adapter.get(), trace, &live, nullptr);
+    }
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+    result.opsPerSecond = static_cast<double>(trace.GetEvents().size() * REPEATS) / elapsed.count();
+    result.latencies.resize(trace.GetEvents().size());
+    ReplayOnce(adapter.get(), trace, &live, result.latencies.data());
+    return result;
+}
+
+/// Producer thread allocates objects and passes them to consumer thread which frees them
+template <class Adapter>
+Result RunProducerConsumer(size_t ops)
+{
+    constexpr size_t QUEUE_SIZE = 1024U;
+    Result result;
+    auto adapter = std::make_unique<Adapter>();
+    std::vector<std::atomic<void *>> queue(QUEUE_SIZE);
+    size_t count = ops / 2U;
+    std::atomic<bool> failed {false};
+    result.latencies.resize(count);
+
+    auto start = Clock::now();
+    std::thread consumer([&]() {
+        for (size_t i = 0; i < count && !failed.load(std::memory_order_relaxed); i++) {
+            void *ptr = nullptr;
+            while ((ptr = queue[i % QUEUE_SIZE].exchange(nullptr, std::memory_order_acquire)) == nullptr) {
+                if (failed.load(std::memory_order_relaxed)) {
+                    return;
+                }
+                std::this_thread::yield();
+            }
+            adapter->Free(ptr);
+        }
+    });
+    std::mt19937 gen(5U);
+    for (size_t i = 0; i < count; i++) {
+        auto allocationStart = Clock::now();
+        void *ptr = adapter->Allocate(16U + gen() % 240U);
+        result.latencies[i] = static_cast<uint64_t>(std::chrono::nanoseconds(Clock::now() - allocationStart).count());
+        if (ptr == nullptr) {
+            failed.store(true, std::memory_order_relaxed);
+            break;
+        }
+        while (queue[i % QUEUE_SIZE].load(std::memory_order_relaxed) != nullptr) {
+            std::this_thread::yield();
+        }
+        queue[i % QUEUE_SIZE].store(ptr, std::memory_order_release);
+    }
+    consumer.join();
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+    result.failed = failed.load();
+    result.opsPerSecond = static_cast<double>(count * 2U) / elapsed.count();
+    return result;
+}
+
+uint64_t Percentile(const std::vector<uint64_t> &sorted, double percentile)
+{
+    auto index = static_cast<size_t>(percentile * static_cast<double>(sorted.size() - 1U));
+    return sorted[index];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+}
+
+void PrintResult(const std::string &pattern, const char *allocator, Result result)
+{
+    if (result.failed || result.latencies.empty()) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+        std::printf("%-22s %-24s %10s\n", pattern.c_str(), allocator, "failed");
+        return;
+    }
+    std::sort(result.latencies.begin(), result.latencies.end());
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+    std::printf("%-22s %-24s %10.2f %9" PRIu64 " %9" PRIu64 " %9" PRIu64 " %9" PRIu64 "\n", pattern.c_str(), allocator,
+                result.opsPerSecond / 1e6, Percentile(result.latencies, 0.5), Percentile(result.latencies, 0.99),
+                Percentile(result.latencies, 0.999), result.latencies.back());
+}
+
+template <class... Adapters>
+void RunAllOnTrace(const AllocationTrace &trace)
+{
+    (PrintResult(trace.GetName(), Adapters::NAME, RunTrace<Adapters>(trace)), ...);
+}
+
+template <class... Adapters>
+void RunAllProducerConsumer(size_t ops)
+{
+    ((Adapters::THREAD_SAFE ? PrintResult("producer_consumer", Adapters::NAME, RunProducerConsumer<Adapters>(ops))
+                            : void()),
+     ...);
+}
+
+/// @returns overhead of one latency measurement, it is included into all latencies
+uint64_t MeasureTimerOverhead()
+{
+    constexpr size_t SAMPLES = 1000U;
+    uint64_t best = UINT64_MAX;
+    for (size_t i = 0; i < SAMPLES; i++) {
+        auto start = Clock::now();
+        best = std::min(best, static_cast<uint64_t>(std::chrono::nanoseconds(Clock::now() - start).count()));
+    }
+    return best;
+}
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    size_t ops = DEFAULT_OPS;
+    std::vector<std::string> traceFiles;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        if (arg == "--ops" && i + 1 < argc) {
+            ops = std::strtoull(argv[++i], nullptr, 10);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        } else if (arg == "--trace" && i + 1 < argc) {
+            traceFiles.emplace_back(argv[++i]);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        } else {
+            std::fprintf(stderr, "usage: %s [--ops <count>] [--trace <file>]...\n", argv[0]);  // NOLINT
+            return 1;
+        }
+    }
+
+    std::vector<AllocationTrace> traces;
+    traces.push_back(MakeLifoTrace(ops));
+    traces.push_back(MakeFifoTrace(ops));
+    traces.push_back(MakeUniformRandomTrace(ops));
+    traces.push_back(MakeSizeMixedTrace(ops));
+    traces.push_back(MakeRequestHandlingTrace(ops));
+    for (const auto &file : traceFiles) {
+        AllocationTrace trace(file.substr(file.find_last_of('/') + 1U));
+        std::string error;
+        if (!LoadTrace(file, &trace, &error)) {
+            std::fprintf(stderr, "can not load trace %s: %s\n", file.c_str(), error.c_str());  // NOLINT
+            return 1;
+        }
+        traces.push_back(std::move(trace));
+    }
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+    std::printf("latency includes timer overhead of %" PRIu64 " ns\n", MeasureTimerOverhead());
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+    std::printf("%-22s %-24s %10s %9s %9s %9s %9s\n", "pattern", "allocator", "Mops/s", "p50 ns", "p99 ns",
+                "p99.9 ns", "max ns");
+    for (const auto &trace : traces) {
+        RunAllOnTrace<MallocAdapter, BumpAdapter, RunOfSlotsAdapter, RunOfSlotsCacheAdapter,
+                      FreeListAdapter<FreeListPolicy::FIRST_FIT>, FreeListAdapter<FreeListPolicy::SEGREGATED_FIT>>(
+            trace);
+    }
+    RunAllProducerConsumer<MallocAdapter, BumpAdapter, RunOfSlotsAdapter, FreeListAdapter<FreeListPolicy::FIRST_FIT>,
+                           FreeListAdapter<FreeListPolicy::SEGREGATED_FIT>>(ops);
+    return 0;
+}
@@ -0,0 +1,172 @@
+#ifndef MEMORY_MANAGEMENT_ALLOCATOR_BENCHMARKS_INCLUDE_ALLOCATION_TRACE_H
+#define MEMORY_MANAGEMENT_ALLOCATOR_BENCHMARKS_INCLUDE_ALLOCATION_TRACE_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <istream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "memory_management/common/include/allocation_recorder.h"
+
+enum class TraceOp : uint8_t { ALLOCATE, FREE };
+
+/// One operation of the trace. Live allocations are numbered by dense slots, so replay keeps them in a plain array.
+struct TraceEvent {
+    TraceOp op;
+    uint32_t slot;
+    uint64_t size;  // is used by ALLOCATE only
+};
+
+/// Sequence of allocations and frees which can be replayed on any allocator
+class AllocationTrace {
+public:
+    explicit AllocationTrace(std::string name) : name_(std::move(name)) {}
+
+    /// @returns slot of the new allocation, slots of freed allocations are reused
+    uint32_t Allocate(uint64_t size)
+    {
+        uint32_t slot = static_cast<uint32_t>(slotsCount_);
+        if (!freeSlots_.empty()) {
+            slot = freeSlots_.back();
+            freeSlots_.pop_back();
+        } else {
+            slotsCount_++;
+        }
+        events_.push_back({TraceOp::ALLOCATE, slot, size});
+        return slot;
+    }
+
+    void Free(uint32_t slot)
+    {
+        events_.push_back({TraceOp::FREE, slot, 0});
+        freeSlots_.push_back(slot);
+    }
+
+    const std::string &GetName() const
+    {
+        return name_;
+    }
+
+    const std::vector<TraceEvent> &GetEvents() const
+    {
+        return events_;
+    }
+
+    /// @returns count of slots which replay should keep
+    size_t GetSlotsCount() const
+    {
+        return slotsCount_;
+    }
+
+private:
+    std::string name_;
+    std::vector<TraceEvent> events_;
+    std::vector<uint32_t> freeSlots_;
+    size_t slotsCount_ {0};
+};
+
+/**
+ * @brief Reads trace in text format: every line is "a <id> <size>" or "f <id>", id is any number which is unique
+ * among live allocations, lines starting with '#' are comments. Ids are remapped to dense slots.
+ * @returns false if @param in has a malformed line, @param error then describes it
+ */
+inline bool LoadTextTrace(std::istream &in, AllocationTrace *trace, std::string *error)
+{
+    std::unordered_map<uint64_t, uint32_t> slots;
+    std::string line;
+    for (size_t lineNumber = 1; std::getline(in, line); lineNumber++) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream fields(line);
+        char op = 0;
+        uint64_t id = 0;
+        fields >> op >> id;
+        if (fields.fail() || (op != 'a' && op != 'f')) {
+            *error = "line " + std::to_string(lineNumber) + ": expected 'a <id> <size>' or 'f <id>'";
+            return false;
+        }
+        if (op == 'a') {
+            uint64_t size = 0;
+            fields >> size;
+            if (fields.fail() || size == 0 || slots.count(id) != 0) {
+                *error = "line " + std::to_string(lineNumber) + ": bad size or id is already allocated";
+                return false;
+            }
+            slots.emplace(id, trace->Allocate(size));
+        } else {
+            auto it = slots.find(id);
+            if (it == slots.end()) {
+                *error = "line " + std::to_string(lineNumber) + ": id is not allocated";
+                return false;
+            }
+            trace->Free(it->second);
+            slots.erase(it);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Reads binary trace written by AllocationRecorder. Records of all threads are merged by timestamp and
+ * replayed as one sequence. Frees of addresses which were allocated before the recording start are skipped,
+ * allocation at an address which is still live (memory of bump allocator after reset) frees the previous one.
+ * @returns false if @param in is not a trace of the supported version, @param error then describes it
+ */
+inline bool LoadBinaryTrace(std::istream &in, AllocationTrace *trace, std::string *error)
+{
+    TraceFileHeader header;
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    if (!in.read(reinterpret_cast<char *>(&header), sizeof(header)) || header.magic != TraceFileHeader::MAGIC) {
+        *error = "not a binary allocation trace";
+        return false;
+    }
+    if (header.version != TraceFileHeader::VERSION || header.recordSize != sizeof(TraceRecord)) {
+        *error = "unsupported trace version " + std::to_string(header.version);
+        return false;
+    }
+    std::vector<TraceRecord> records;
+    TraceRecord record {};
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    while (in.read(reinterpret_cast<char *>(&record), sizeof(record))) {
+        records.push_back(record);
+    }
+    std::stable_sort(records.begin(), records.end(),
+                     [](const TraceRecord &lhs, const TraceRecord &rhs) { return lhs.timestamp < rhs.timestamp; });
+    std::unordered_map<uint64_t, uint32_t> slots;
+    for (const TraceRecord &event : records) {
+        auto it = slots.find(event.address);
+        if (it != slots.end()) {
+            trace->Free(it->second);
+            slots.erase(it);
+        }
+        if (event.op == TraceRecordOp::ALLOCATE) {
+            slots.emplace(event.address, trace->Allocate(std::max<uint64_t>(event.size, 1U)));
+        }
+    }
+    return true;
+}
+
+/// @brief Reads trace from file @param path in binary or text format
+inline bool LoadTrace(const std::string &path, AllocationTrace *trace, std::string *error)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        *error = "can not open " + path;
+        return false;
+    }
+    std::array<char, TraceFileHeader::MAGIC.size()> magic {};
+    in.read(magic.data(), magic.size());
+    bool isBinary = in.gcount() == static_cast<std::streamsize>(magic.size()) && magic == TraceFileHeader::MAGIC;
+    in.clear();
+    in.seekg(0);
+    return isBinary ? LoadBinaryTrace(in, trace, error) : LoadTextTrace(in, trace, error);
+}
+
+#endif  // MEMORY_MANAGEMENT_ALLOCATOR_BENCHMARKS_INCLUDE_ALLOCATION_TRACE_H
@@ -0,0 +1,159 @@
+#ifndef MEMORY_MANAGEMENT_ALLOCATOR_BENCHMARKS_INCLUDE_ALLOCATOR_ADAPTERS_H
+#define MEMORY_MANAGEMENT_ALLOCATOR_BENCHMARKS_INCLUDE_ALLOCATOR_ADAPTERS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include "memory_management/bump_pointer_allocator/include/growable_bump_pointer_allocator.h"
+#include "memory_management/common/include/allocator_stats.h"
+#include "memory_management/free_list_allocator/include/free_list_allocator.h"
+#include "memory_management/run_of_slots_allocator/include/run_of_slots_allocator.h"
+
+// Adapters give all allocators the same interface for benchmarks and trace replay:
+// Allocate(size), Free(ptr), Reset() which is called after the whole trace, and GetStats()
+
+inline constexpr size_t ADAPTER_RUN_SIZE = 64U * 1024U;
+inline constexpr size_t ADAPTER_FREE_LIST_POOL_SIZE = 1024U * 1024U;
+inline constexpr size_t ADAPTER_BUMP_REGION_SIZE = 1024U * 1024U;
+
+class MallocAdapter {
+public:
+    static constexpr const char *NAME = "malloc";
+    static constexpr bool THREAD_SAFE = true;
+    static constexpr bool HAS_STATS = false;
+
+    void *Allocate(size_t size)
+    {
+        return std::malloc(size);  // NOLINT(cppcoreguidelines-no-malloc)
+    }
+
+    void Free(void *ptr)
+    {
+        std::free(ptr);  // NOLINT(cppcoreguidelines-no-malloc)
+    }
+
+    void Reset() {}
+
+    AllocatorStats GetStats()
+    {
+        return {};
+    }
+};
+
+/// Bump allocator can not free single objects, all memory is released by Reset after the whole trace
+class BumpAdapter {
+public:
+    static constexpr const char *NAME = "bump";
+    static constexpr bool THREAD_SAFE = false;
+    static constexpr bool HAS_STATS = true;
+
+    void *Allocate(size_t size)
+    {
+        return allocator_.Allocate<uint8_t>(size, alignof(std::max_align_t));
+    }
+
+    void Free([[maybe_unused]] void *ptr) {}
+
+    void Reset()
+    {
+        allocator_.Free();
+    }
+
+    AllocatorStats GetStats()
+    {
+        return allocator_.GetStats();
+    }
+
+private:
+    GrowableBumpPointerAllocator<ADAPTER_BUMP_REGION_SIZE> allocator_;
+};
+
+using AdapterSlotsAllocator = RunOfSlotsAllocator<ADAPTER_RUN_SIZE, 16U, 32U, 48U, 64U, 96U, 128U, 192U, 256U, 384U,
+                                                  512U, 768U, 1024U, 1536U, 2048U, 3072U, 4096U>;
+
+class RunOfSlotsAdapter {
+public:
+    static constexpr const char *NAME = "run_of_slots";
+    static constexpr bool THREAD_SAFE = true;
+    static constexpr bool HAS_STATS = true;
+
+    void *Allocate(size_t size)
+    {
+        return allocator_.Allocate(size);
+    }
+
+    void Free(void *ptr)
+    {
+        allocator_.Free(ptr);
+    }
+
+    void Reset() {}
+
+    AllocatorStats GetStats()
+    {
+        return allocator_.GetStats();
+    }
+
+private:
+    AdapterSlotsAllocator allocator_ {AdapterSlotsAllocator::RetentionPolicy {SIZE_MAX, 1U}};
+};
+
+class RunOfSlotsCacheAdapter {
+public:
+    static constexpr const char *NAME = "run_of_slots+cache";
+    static constexpr bool THREAD_SAFE = false;
+    static constexpr bool HAS_STATS = true;
+
+    void *Allocate(size_t size)
+    {
+        return cache_.Allocate(size);
+    }
+
+    void Free(void *ptr)
+    {
+        cache_.Free(ptr);
+    }
+
+    void Reset() {}
+
+    /// slots kept in the cache are reported as used
+    AllocatorStats GetStats()
+    {
+        return allocator_.GetStats();
+    }
+
+private:
+    AdapterSlotsAllocator allocator_ {AdapterSlotsAllocator::RetentionPolicy {SIZE_MAX, 1U}};
+    AdapterSlotsAllocator::ThreadCache cache_ {allocator_};
+};
+
+template <FreeListPolicy POLICY>
+class FreeListAdapter {
+public:
+    static constexpr const char *NAME =
+        POLICY == FreeListPolicy::SEGREGATED_FIT ? "free_list(segregated)" : "free_list(first_fit)";
+    static constexpr bool THREAD_SAFE = true;
+    static constexpr bool HAS_STATS = true;
+
+    void *Allocate(size_t size)
+    {
+        return allocator_.template Allocate<uint8_t>(size);
+    }
+
+    void Free(void *ptr)
+    {
+        allocator_.Free(ptr);
+    }
+
+    void Reset() {}
+
+    AllocatorStats GetStats()
+    {
+        return allocator_.GetStats();
+    }
+
+private:
+    FreeListAllocator<ADAPTER_FREE_LIST_POOL_SIZE, POLICY> allocator_;
+};
+
+#endif  // MEMORY_MANAGEMENT_ALLOCATOR_BENCHMARKS_INCLUDE_ALLOCATOR_ADAPTERS_H
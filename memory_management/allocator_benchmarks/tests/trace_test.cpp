@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "memory_management/allocator_benchmarks/include/allocation_trace.h"
+#include "memory_management/common/include/allocation_recorder.h"
+#include "memory_management/free_list_allocator/include/free_list_allocator.h"
+
+namespace {
+
+std::string GetTracePath()
+{
+    return ::testing::TempDir() + "allocation_trace_" + std::to_string(getpid()) + ".bin";
+}
+
+}  // namespace
+
+TEST(AllocationTraceTest, TextTraceTest)
+{
+    std::istringstream in("# comment\na 10 32\na 20 64\nf 10\na 30 16\nf 20\nf 30\n");
+    AllocationTrace trace("text");
+    std::string error;
+    ASSERT_TRUE(LoadTextTrace(in, &trace, &error)) << error;
+    const auto &events = trace.GetEvents();
+    ASSERT_EQ(events.size(), 6U);
+    ASSERT_EQ(events[0].op, TraceOp::ALLOCATE);
+    ASSERT_EQ(events[0].size, 32U);
+    ASSERT_EQ(events[2].op, TraceOp::FREE);
+    // slot of the freed allocation is reused
+    ASSERT_EQ(events[3].slot, events[0].slot);
+    ASSERT_EQ(trace.GetSlotsCount(), 2U);
+
+    std::istringstream bad("a 1 32\nf 2\n");
+    AllocationTrace badTrace("bad");
+    ASSERT_FALSE(LoadTextTrace(bad, &badTrace, &error));
+    ASSERT_NE(error.find("line 2"), std::string::npos);
+}
+
+TEST(AllocationTraceTest, RecordAndLoadTest)
+{
+    constexpr size_t THREADS_COUNT = 4U;
+    // more than buffer capacity, so buffers are flushed during recording
+    constexpr size_t ALLOCATIONS_COUNT = AllocationRecorder::BUFFER_CAPACITY;
+    std::string path = GetTracePath();
+    ASSERT_TRUE(AllocationRecorder::Start(path.c_str()));
+    ASSERT_FALSE(AllocationRecorder::Start(path.c_str()));
+    ASSERT_TRUE(AllocationRecorder::IsRecording());
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < THREADS_COUNT; i++) {
+        threads.emplace_back([i]() {
+            std::vector<uint64_t> objects(ALLOCATIONS_COUNT);
+            for (size_t j = 0; j < ALLOCATIONS_COUNT; j++) {
+                AllocationRecorder::Record(TraceRecordOp::ALLOCATE, &objects[j], i + 1U, 0);
+            }
+            for (size_t j = 0; j < ALLOCATIONS_COUNT; j++) {
+                AllocationRecorder::Record(TraceRecordOp::FREE, &objects[j], 0, AllocationRecorder::NO_SIZE_CLASS);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    // records of this thread are flushed by Stop, sizes above 4 GiB are not truncated
+    constexpr uint64_t HUGE_SIZE = uint64_t(5) << 30U;
+    uint64_t object = 0;
+    AllocationRecorder::Record(TraceRecordOp::ALLOCATE, &object, HUGE_SIZE, 0);
+    AllocationRecorder::Stop();
+    ASSERT_FALSE(AllocationRecorder::IsRecording());
+
+    AllocationTrace trace("recorded");
+    std::string error;
+    ASSERT_TRUE(LoadTrace(path, &trace, &error)) << error;
+    unlink(path.c_str());
+    const auto &events = trace.GetEvents();
+    ASSERT_EQ(events.size(), THREADS_COUNT * ALLOCATIONS_COUNT * 2U + 1U);
+    ASSERT_EQ(events.back().size, HUGE_SIZE);
+    size_t allocations = 0;
+    size_t live = 0;
+    size_t maxLive = 0;
+    for (const TraceEvent &event : events) {
+        if (event.op == TraceOp::ALLOCATE) {
+            allocations++;
+            live++;
+            ASSERT_GE(event.size, 1U);
+            ASSERT_TRUE(event.size <= THREADS_COUNT || event.size == HUGE_SIZE);
+        } else {
+            live--;
+        }
+        maxLive = std::max(maxLive, live);
+    }
+    ASSERT_EQ(allocations, THREADS_COUNT * ALLOCATIONS_COUNT + 1U);
+    ASSERT_EQ(live, 1U);
+    ASSERT_EQ(trace.GetSlotsCount(), maxLive);
+}
+
+TEST(AllocationTraceTest, AllocatorHooksTest)
+{
+    if constexpr (!ALLOCATION_TRACE_ENABLED) {
+        GTEST_SKIP() << "allocators are built without PROJECT_ENABLE_ALLOCATION_TRACE";
+    }
+    constexpr size_t MEMORY_POOL_SIZE = 4096U;
+    FreeListAllocator<MEMORY_POOL_SIZE> allocator;
+    std::string path = GetTracePath();
+    ASSERT_TRUE(AllocationRecorder::Start(path.c_str()));
+    auto *first = allocator.Allocate<uint8_t>(100U);
+    auto *second = allocator.Allocate<uint8_t>(200U);
+    allocator.Free(first);
+    allocator.Free(second);
+    AllocationRecorder::Stop();
+
+    AllocationTrace trace("hooks");
+    std::string error;
+    ASSERT_TRUE(LoadTrace(path, &trace, &error)) << error;
+    unlink(path.c_str());
+    const auto &events = trace.GetEvents();
+    ASSERT_EQ(events.size(), 4U);
+    ASSERT_EQ(events[0].size, 100U);
+    ASSERT_EQ(events[1].size, 200U);
+    ASSERT_EQ(events[2].op, TraceOp::FREE);
+    ASSERT_EQ(events[2].slot, events[0].slot);
+    ASSERT_EQ(events[3].slot, events[1].slot);
+}
@@ -0,0 +1,166 @@
+/**
+ * Replays recorded allocation trace on the project allocators and malloc and reports replay time, peak RSS and
+ * fragmentation at the moment of the peak live memory. Every allocator is replayed in a forked process, so its
+ * peak RSS is not affected by the others.
+ * Usage: trace_replay <trace file> [--allocator <name>]...
+ */
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+#include "memory_management/allocator_benchmarks/include/allocation_trace.h"
+#include "memory_management/allocator_benchmarks/include/allocator_adapters.h"
+
+namespace {
+
+constexpr double BYTES_IN_MB = 1024.0 * 1024.0;
+
+/// @returns index of the event after which live bytes of @param trace are at maximum
+size_t FindPeakEvent(const AllocationTrace &trace)
+{
+    std::vector<uint64_t> sizes(trace.GetSlotsCount(), 0);
+    size_t live = 0;
+    size_t peak = 0;
+    size_t peakEvent = 0;
+    const auto &events = trace.GetEvents();
+    for (size_t i = 0; i < events.size(); i++) {
+        const TraceEvent &event = events[i];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+        if (event.op == TraceOp::ALLOCATE) {
+            sizes[event.slot] = event.size;  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+            live += event.size;
+        } else {
+            live -= sizes[event.slot];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+        }
+        if (live > peak) {
+            peak = live;
+            peakEvent = i;
+        }
+    }
+    return peakEvent;
+}
+
+long GetPeakRssKb()
+{
+    rusage usage {};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+template <class Adapter>
+void Replay(const AllocationTrace &trace, size_t peakEvent)
+{
+    long rssBefore = GetPeakRssKb();
+    auto adapter = std::make_unique<Adapter>();
+    std::vector<void *> live(trace.GetSlotsCount(), nullptr);
+    AllocatorStats peakStats;
+    std::chrono::duration<double> elapsed {0};
+    const auto &events = trace.GetEvents();
+    for (size_t i = 0; i < events.size(); i++) {
+        auto start = std::chrono::steady_clock::now();
+        const TraceEvent &event = events[i];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+        void *&slot = live[event.slot];
+        if (event.op == TraceOp::ALLOCATE) {
+            slot = adapter->Allocate(event.size);
+            if (slot == nullptr) {
+                // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+                std::printf("%-24s failed at event %zu: no memory for %" PRIu64 " bytes\n", Adapter::NAME, i,
+                            event.size);
+                return;
+            }
+            *static_cast<volatile uint8_t *>(slot) = 1U;
+        } else {
+            adapter->Free(slot);
+            slot = nullptr;
+        }
+        elapsed += std::chrono::steady_clock::now() - start;
+        if (i == peakEvent) {
+            peakStats = adapter->GetStats();
+        }
+    }
+    long rssPeak = GetPeakRssKb();
+    if (Adapter::HAS_STATS) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+        std::printf("%-24s %10.2f %10.2f %12.2f %12.2f %12.2f %10.3f\n", Adapter::NAME, elapsed.count() * 1e3,
+                    static_cast<double>(rssPeak - rssBefore) / 1024.0,
+                    static_cast<double>(peakStats.bytesReserved) / BYTES_IN_MB,
+                    static_cast<double>(peakStats.bytesUsed) / BYTES_IN_MB,
+                    static_cast<double>(peakStats.bytesFree) / BYTES_IN_MB, peakStats.GetExternalFragmentation());
+    } else {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+        std::printf("%-24s %10.2f %10.2f %12s %12s %12s %10s\n", Adapter::NAME, elapsed.count() * 1e3,
+                    static_cast<double>(rssPeak - rssBefore) / 1024.0, "-", "-", "-", "-");
+    }
+}
+
+/// @brief Runs replay in a child process to measure its peak RSS separately
+template <class Adapter>
+void ReplayIsolated(const AllocationTrace &trace, size_t peakEvent, const std::vector<std::string> &selected)
+{
+    if (!selected.empty() && std::find(selected.begin(), selected.end(), Adapter::NAME) == selected.end()) {
+        return;
+    }
+    std::fflush(stdout);
+    pid_t pid = fork();
+    if (pid == 0) {
+        Replay<Adapter>(trace, peakEvent);
+        std::fflush(stdout);
+        _exit(0);
+    }
+    if (pid < 0) {
+        // without fork RSS of the previous replays is included
+        Replay<Adapter>(trace, peakEvent);
+        return;
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+}
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <trace file> [--allocator <name>]...\n", argv[0]);  // NOLINT
+        return 1;
+    }
+    std::string file = argv[1];  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    std::vector<std::string> selected;
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        if (arg == "--allocator" && i + 1 < argc) {
+            selected.emplace_back(argv[++i]);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        } else {
+            std::fprintf(stderr, "unknown argument %s\n", arg.c_str());  // NOLINT(cppcoreguidelines-pro-type-vararg)
+            return 1;
+        }
+    }
+
+    AllocationTrace trace(file);
+    std::string error;
+    if (!LoadTrace(file, &trace, &error)) {
+        std::fprintf(stderr, "can not load trace %s: %s\n", file.c_str(), error.c_str());  // NOLINT
+        return 1;
+    }
+    size_t peakEvent = FindPeakEvent(trace);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+    std::printf("trace %s: %zu events, stats are taken at the peak of live memory (event %zu)\n", file.c_str(),
+                trace.GetEvents().size(), peakEvent);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+    std::printf("%-24s %10s %10s %12s %12s %12s %10s\n", "allocator", "time ms", "rss MB", "reserved MB", "used MB",
+                "free MB", "ext frag");
+    ReplayIsolated<MallocAdapter>(trace, peakEvent, selected);
+    ReplayIsolated<BumpAdapter>(trace, peakEvent, selected);
+    ReplayIsolated<RunOfSlotsAdapter>(trace, peakEvent, selected);
+    ReplayIsolated<RunOfSlotsCacheAdapter>(trace, peakEvent, selected);
+    ReplayIsolated<FreeListAdapter<FreeListPolicy::FIRST_FIT>>(trace, peakEvent, selected);
+    ReplayIsolated<FreeListAdapter<FreeListPolicy::SEGREGATED_FIT>>(trace, peakEvent, selected);
+    return 0;
+}
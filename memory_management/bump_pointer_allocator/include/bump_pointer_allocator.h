@@ -1,42 +1,329 @@
 #ifndef MEMORY_MANAGEMENT_BUMP_POINTER_ALLOCATOR_INCLUDE_BUMP_POINTER_ALLOCATOR_H
 #define MEMORY_MANAGEMENT_BUMP_POINTER_ALLOCATOR_INCLUDE_BUMP_POINTER_ALLOCATOR_H
 
+#include <array>
+#include <atomic>
 #include <cstddef>  // is used for size_t
 #include <cstdint>
 #include "base/macros.h"
+#include "memory_management/common/include/allocation_recorder.h"
+#include "memory_management/common/include/allocator_stats.h"
 
 template <size_t MEMORY_POOL_SIZE>
 class BumpPointerAllocator {
 public:
+    class Tlab;
+    class ArenaScope;
+
+    /// Position of the bump pointer saved by Checkpoint
+    class Mark {
+    public:
+        DEFAULT_COPY_SEMANTIC(Mark);
+        DEFAULT_MOVE_SEMANTIC(Mark);
+        ~Mark() = default;
+
+    private:
+        explicit Mark(size_t top) : top_(top) {}
+
+        size_t top_;
+
+        friend class BumpPointerAllocator;
+    };
+
     BumpPointerAllocator() = default;
     ~BumpPointerAllocator() = default;
     NO_COPY_SEMANTIC(BumpPointerAllocator);
     NO_MOVE_SEMANTIC(BumpPointerAllocator);
 
+    static constexpr size_t MAX_ALIGNMENT = 4096U;
+
+    /**
+     * @brief Allocates memory for @param count objects of type T from the shared pool. Memory is aligned by
+     * @param alignment which must be a power of two not greater than MAX_ALIGNMENT.
+     * Method is not thread-safe, use AllocateConcurrent or Tlab to allocate from several threads.
+     * @returns pointer to allocated memory or nullptr if pool is exhausted
+     */
+    template <class T = uint8_t>
+    T *Allocate(size_t count, size_t alignment = alignof(T))
+    {
+        size_t size = 0;
+        if (!GetAllocationSize<T>(count, alignment, &size)) {
+            counters_.OnAllocate(false);
+            return nullptr;
+        }
+        size_t top = top_.load(std::memory_order_relaxed);
+        size_t offset = AlignOffset(top, alignment);
+        if (!IsFit(offset, size)) {
+            counters_.OnAllocate(false);
+            return nullptr;
+        }
+        top_.store(offset + size, std::memory_order_relaxed);
+        counters_.OnAllocate(true);
+        TraceAllocate(ToPtr(offset), size);
+        return reinterpret_cast<T *>(ToPtr(offset));  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    }
+
+    /**
+     * @brief Thread-safe version of Allocate. Space is reserved with CAS, so failed allocation does not change
+     * the pool and concurrent allocations never overlap.
+     * @returns pointer to allocated memory or nullptr if pool is exhausted
+     */
     template <class T = uint8_t>
-    T *Allocate([[maybe_unused]] size_t count)  // TODO(you): remove [[maybe_unused]]
+    T *AllocateConcurrent(size_t count, size_t alignment = alignof(T))
     {
-        // TODO(you): Add your implementation here...
-        return nullptr;
+        size_t size = 0;
+        if (!GetAllocationSize<T>(count, alignment, &size)) {
+            counters_.OnAllocate(false);
+            return nullptr;
+        }
+        size_t top = top_.load(std::memory_order_relaxed);
+        size_t offset = 0;
+        do {
+            offset = AlignOffset(top, alignment);
+            if (!IsFit(offset, size)) {
+                counters_.OnAllocate(false);
+                return nullptr;
+            }
+        } while (!top_.compare_exchange_weak(top, offset + size, std::memory_order_relaxed));
+        counters_.OnAllocate(true);
+        TraceAllocate(ToPtr(offset), size);
+        return reinterpret_cast<T *>(ToPtr(offset));  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
     }
 
+    /**
+     * @brief Releases all memory of the allocator. All Tlabs are invalidated and will be refilled on the next
+     * allocation. Must not be called concurrently with allocations.
+     */
     void Free()
     {
-        // TODO(you): Add your implementation here...
+        top_.store(0, std::memory_order_relaxed);
+        epoch_.fetch_add(1, std::memory_order_release);
+        counters_.OnFree();
+    }
+
+    /// @returns current position of the bump pointer which can be passed to Rewind later
+    Mark Checkpoint() const
+    {
+        size_t top = top_.load(std::memory_order_relaxed);
+        return Mark(top < MEMORY_POOL_SIZE ? top : MEMORY_POOL_SIZE);
+    }
+
+    /**
+     * @brief Releases all memory allocated after @param mark was taken, memory allocated before stays alive.
+     * Tlabs are invalidated like in Free. Must not be called concurrently with allocations.
+     */
+    void Rewind(Mark mark)
+    {
+        assert(mark.top_ <= top_.load(std::memory_order_relaxed));
+        top_.store(mark.top_, std::memory_order_relaxed);
+        epoch_.fetch_add(1, std::memory_order_release);
+        counters_.OnFree();
     }
 
     /**
      * @brief Method should check in @param ptr is pointer to mem from this allocator
      * @returns true if ptr is from this allocator
      */
-    bool VerifyPtr([[maybe_unused]] void *ptr)  // TODO(you): remove [[maybe_unused]]
+    bool VerifyPtr(void *ptr)
+    {
+        auto addr = reinterpret_cast<uintptr_t>(ptr);  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        auto begin = reinterpret_cast<uintptr_t>(pool_.data());  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        size_t top = top_.load(std::memory_order_acquire);
+        // top can overshoot the pool when Tlab refill fails
+        size_t used = top < MEMORY_POOL_SIZE ? top : MEMORY_POOL_SIZE;
+        return addr >= begin && addr < begin + used;
+    }
+
+    /**
+     * @returns snapshot of the pool usage. Chunks reserved by Tlabs are accounted as used, allocations done by a Tlab
+     * are counted when it refills or is destroyed. Free and Rewind are counted as frees.
+     */
+    AllocatorStats GetStats() const
+    {
+        AllocatorStats stats;
+        size_t top = top_.load(std::memory_order_relaxed);
+        stats.bytesReserved = MEMORY_POOL_SIZE;
+        stats.bytesUsed = top < MEMORY_POOL_SIZE ? top : MEMORY_POOL_SIZE;
+        stats.AddFreeBlock(MEMORY_POOL_SIZE - stats.bytesUsed);
+        counters_.Fill(&stats);
+        return stats;
+    }
+
+private:
+    /**
+     * @brief Reserves @param size bytes for a Tlab with one atomic fetch-add. Failed reservation leaves top
+     * beyond the pool end, so the pool stays exhausted until Free.
+     * @returns pointer to reserved memory or nullptr
+     */
+    uint8_t *ReserveChunk(size_t size)
+    {
+        size_t top = top_.fetch_add(size, std::memory_order_relaxed);
+        if (top > MEMORY_POOL_SIZE || size > MEMORY_POOL_SIZE - top) {
+            return nullptr;
+        }
+        return ToPtr(top);
+    }
+
+    template <class T>
+    static bool GetAllocationSize(size_t count, size_t alignment, size_t *size)
+    {
+        assert(IsValidAlignment(alignment));
+        if (count == 0 || count > MEMORY_POOL_SIZE / sizeof(T)) {
+            return false;
+        }
+        *size = count * sizeof(T);
+        return true;
+    }
+
+    static constexpr bool IsValidAlignment(size_t alignment)
+    {
+        return alignment != 0 && (alignment & (alignment - 1)) == 0 && alignment <= MAX_ALIGNMENT;
+    }
+
+    static bool IsFit(size_t offset, size_t size)
+    {
+        return offset <= MEMORY_POOL_SIZE && size <= MEMORY_POOL_SIZE - offset;
+    }
+
+    /// @returns offset of the first address not less than pool begin + offset, aligned by alignment
+    size_t AlignOffset(size_t offset, size_t alignment)
+    {
+        auto begin = reinterpret_cast<uintptr_t>(pool_.data());  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        uintptr_t aligned = (begin + offset + alignment - 1) & ~(alignment - 1);
+        return aligned - begin;
+    }
+
+    uint8_t *ToPtr(size_t offset)
+    {
+        return pool_.data() + offset;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    size_t GetEpoch() const
+    {
+        return epoch_.load(std::memory_order_acquire);
+    }
+
+    alignas(std::max_align_t) std::array<uint8_t, MEMORY_POOL_SIZE> pool_ {};
+    std::atomic<size_t> top_ {0};
+    // is incremented on every Free, so Tlabs can find out that their chunk is not valid anymore
+    std::atomic<size_t> epoch_ {0};
+    AllocatorCounters<> counters_;
+};
+
+/**
+ * Thread local allocation buffer. Each thread should own its Tlab: chunk of CHUNK_SIZE bytes is reserved from the
+ * shared pool with one atomic operation and then allocations inside the chunk are done without any atomics.
+ * Requests larger than the chunk are reserved from the shared pool directly.
+ */
+template <size_t MEMORY_POOL_SIZE>
+class BumpPointerAllocator<MEMORY_POOL_SIZE>::Tlab {
+public:
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 256U;
+
+    explicit Tlab(BumpPointerAllocator &allocator, size_t chunkSize = DEFAULT_CHUNK_SIZE)
+        : allocator_(allocator), chunkSize_(chunkSize)
+    {
+    }
+    ~Tlab()
+    {
+        counters_.FlushTo(&allocator_.counters_);
+    }
+    NO_COPY_SEMANTIC(Tlab);
+    NO_MOVE_SEMANTIC(Tlab);
+
+    template <class T = uint8_t>
+    T *Allocate(size_t count, size_t alignment = alignof(T))
+    {
+        assert(IsValidAlignment(alignment));
+        if (count == 0 || count > MEMORY_POOL_SIZE / sizeof(T)) {
+            counters_.OnAllocate(false);
+            return nullptr;
+        }
+        size_t size = count * sizeof(T);
+        if (UNLIKELY(epoch_ != allocator_.GetEpoch())) {
+            // allocator was freed, current chunk belongs to somebody else now
+            Reset();
+        }
+        uint8_t *mem = AlignPtr(cur_, alignment);
+        if (UNLIKELY(cur_ == nullptr || mem > end_ || size > static_cast<size_t>(end_ - mem))) {
+            if (size + alignment - 1 > chunkSize_) {
+                uint8_t *chunk = AlignPtr(allocator_.ReserveChunk(size + alignment - 1), alignment);
+                counters_.OnAllocate(chunk != nullptr);
+                TraceAllocate(chunk, size);
+                return reinterpret_cast<T *>(chunk);  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+            }
+            if (!Refill()) {
+                counters_.OnAllocate(false);
+                return nullptr;
+            }
+            mem = AlignPtr(cur_, alignment);
+        }
+        counters_.OnAllocate(true);
+        TraceAllocate(mem, size);
+        cur_ = mem + size;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        return reinterpret_cast<T *>(mem);  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    }
+
+    /// @returns count of bytes which can be allocated without refill
+    size_t GetFreeSize() const
+    {
+        return static_cast<size_t>(end_ - cur_);
+    }
+
+    /// @brief Drops the rest of the current chunk, the next allocation will refill the Tlab
+    void Reset()
+    {
+        cur_ = nullptr;
+        end_ = nullptr;
+        epoch_ = allocator_.GetEpoch();
+    }
+
+private:
+    static uint8_t *AlignPtr(uint8_t *ptr, size_t alignment)
+    {
+        auto addr = reinterpret_cast<uintptr_t>(ptr);  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast, performance-no-int-to-ptr)
+        return reinterpret_cast<uint8_t *>((addr + alignment - 1) & ~(alignment - 1));
+    }
+
+    bool Refill()
+    {
+        counters_.FlushTo(&allocator_.counters_);
+        epoch_ = allocator_.GetEpoch();
+        uint8_t *chunk = allocator_.ReserveChunk(chunkSize_);
+        if (chunk == nullptr) {
+            cur_ = nullptr;
+            end_ = nullptr;
+            return false;
+        }
+        cur_ = chunk;
+        end_ = chunk + chunkSize_;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        return true;
+    }
+
+    BumpPointerAllocator &allocator_;
+    size_t chunkSize_;
+    size_t epoch_ {0};
+    uint8_t *cur_ {nullptr};
+    uint8_t *end_ {nullptr};
+    LocalAllocatorCounters<> counters_;
+};
+
+/// RAII frame of the arena: all memory allocated during the scope lifetime is released in the destructor
+template <size_t MEMORY_POOL_SIZE>
+class BumpPointerAllocator<MEMORY_POOL_SIZE>::ArenaScope {
+public:
+    explicit ArenaScope(BumpPointerAllocator &allocator) : allocator_(allocator), mark_(allocator.Checkpoint()) {}
+    ~ArenaScope()
     {
-        // TODO(you): Add your implementation here...
-        return false;
+        allocator_.Rewind(mark_);
     }
+    NO_COPY_SEMANTIC(ArenaScope);
+    NO_MOVE_SEMANTIC(ArenaScope);
 
 private:
-    // TODO(you): Add your fields and methods here...
+    BumpPointerAllocator &allocator_;
+    Mark mark_;
 };
 
-#endif  // MEMORY_MANAGEMENT_BUMP_POINTER_ALLOCATOR_INCLUDE_BUMP_POINTER_ALLOCATOR_H
\ No newline at end of file
+#endif  // MEMORY_MANAGEMENT_BUMP_POINTER_ALLOCATOR_INCLUDE_BUMP_POINTER_ALLOCATOR_H
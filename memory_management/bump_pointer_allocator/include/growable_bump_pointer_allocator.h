@@ -0,0 +1,203 @@
+#ifndef MEMORY_MANAGEMENT_BUMP_POINTER_ALLOCATOR_INCLUDE_GROWABLE_BUMP_POINTER_ALLOCATOR_H
+#define MEMORY_MANAGEMENT_BUMP_POINTER_ALLOCATOR_INCLUDE_GROWABLE_BUMP_POINTER_ALLOCATOR_H
+
+#include <sys/mman.h>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include "base/macros.h"
+#include "memory_management/common/include/allocation_recorder.h"
+#include "memory_management/common/include/allocator_stats.h"
+
+/**
+ * Bump pointer allocator which does not reserve memory for the worst case. It starts with one region of REGION_SIZE
+ * bytes and maps a new region from the OS when the current one is exhausted. Regions are aligned by REGION_SIZE and
+ * start with a header, allocations larger than one region get a dedicated region of several REGION_SIZE.
+ * Free keeps only the first region and returns the others to the OS.
+ */
+template <size_t REGION_SIZE>
+class GrowableBumpPointerAllocator {
+    static constexpr size_t PAGE_SIZE = 4096U;
+    static_assert(REGION_SIZE >= PAGE_SIZE && (REGION_SIZE & (REGION_SIZE - 1)) == 0,
+                  "region size should be a power of two not less than page size");
+
+    struct RegionHeader {
+        RegionHeader *next;
+        size_t size;  // size of the whole region including the header
+        size_t top;   // offset of the first free byte from the region begin
+    };
+
+public:
+    static constexpr size_t MAX_ALIGNMENT = PAGE_SIZE;
+    // rounding of a region up to REGION_SIZE and its over-mapping for the alignment should not overflow
+    static constexpr size_t MAX_ALLOCATION_SIZE = SIZE_MAX - 2U * REGION_SIZE - MAX_ALIGNMENT - sizeof(RegionHeader);
+
+    /// @param useHugePages - hint OS to back regions with transparent huge pages
+    explicit GrowableBumpPointerAllocator(bool useHugePages = false) : useHugePages_(useHugePages) {}
+    ~GrowableBumpPointerAllocator()
+    {
+        Free();
+        if (first_ != nullptr) {
+            UnmapRegion(first_);
+        }
+    }
+    NO_COPY_SEMANTIC(GrowableBumpPointerAllocator);
+    NO_MOVE_SEMANTIC(GrowableBumpPointerAllocator);
+
+    /**
+     * @brief Allocates memory for @param count objects of type T aligned by @param alignment.
+     * Maps a new region if the current one has no space.
+     * @returns pointer to allocated memory or nullptr if OS has no memory or size exceeds MAX_ALLOCATION_SIZE
+     */
+    template <class T = uint8_t>
+    T *Allocate(size_t count, size_t alignment = alignof(T))
+    {
+        assert(alignment != 0 && (alignment & (alignment - 1)) == 0 && alignment <= MAX_ALIGNMENT);
+        if (count == 0 || count > MAX_ALLOCATION_SIZE / sizeof(T)) {
+            counters_.OnAllocate(false);
+            return nullptr;
+        }
+        size_t size = count * sizeof(T);
+        void *mem = current_ != nullptr ? AllocateInRegion(current_, size, alignment) : nullptr;
+        if (UNLIKELY(mem == nullptr)) {
+            RegionHeader *region = MapRegion(sizeof(RegionHeader) + size + alignment - 1);
+            if (region == nullptr) {
+                counters_.OnAllocate(false);
+                return nullptr;
+            }
+            if (current_ == nullptr) {
+                first_ = region;
+            } else {
+                current_->next = region;
+            }
+            current_ = region;
+            mem = AllocateInRegion(current_, size, alignment);
+            assert(mem != nullptr);
+        }
+        counters_.OnAllocate(true);
+        TraceAllocate(mem, size);
+        return static_cast<T *>(mem);
+    }
+
+    /// @brief Releases all memory, every region except the first one is returned to OS
+    void Free()
+    {
+        if (first_ == nullptr) {
+            return;
+        }
+        RegionHeader *region = first_->next;
+        while (region != nullptr) {
+            RegionHeader *next = region->next;
+            UnmapRegion(region);
+            region = next;
+        }
+        first_->next = nullptr;
+        first_->top = sizeof(RegionHeader);
+        current_ = first_;
+        counters_.OnFree();
+    }
+
+    /**
+     * @brief Method should check in @param ptr is pointer to mem from this allocator
+     * @returns true if ptr is from this allocator
+     */
+    bool VerifyPtr(void *ptr) const
+    {
+        auto addr = reinterpret_cast<uintptr_t>(ptr);  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        // ptr can be foreign, so region base is compared with the chain instead of reading a header at it
+        uintptr_t base = addr & ~(REGION_SIZE - 1);
+        for (RegionHeader *region = first_; region != nullptr; region = region->next) {
+            auto begin = reinterpret_cast<uintptr_t>(region);  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+            // large regions span several aligned blocks, so the base of ptr is not always the region begin
+            if (base >= begin && base < begin + region->size) {
+                return addr >= begin + sizeof(RegionHeader) && addr < begin + region->top;
+            }
+        }
+        return false;
+    }
+
+    /// @returns count of regions currently mapped by the allocator
+    size_t GetRegionsCount() const
+    {
+        size_t count = 0;
+        for (RegionHeader *region = first_; region != nullptr; region = region->next) {
+            count++;
+        }
+        return count;
+    }
+
+    /**
+     * @returns snapshot of the regions usage. Region headers are accounted as used, only the tail of the current
+     * region is free: tails of the previous regions are never allocated from again.
+     */
+    AllocatorStats GetStats() const
+    {
+        AllocatorStats stats;
+        for (RegionHeader *region = first_; region != nullptr; region = region->next) {
+            stats.bytesReserved += region->size;
+            stats.bytesUsed += region->top;
+        }
+        if (current_ != nullptr) {
+            stats.AddFreeBlock(current_->size - current_->top);
+        }
+        counters_.Fill(&stats);
+        return stats;
+    }
+
+private:
+    static void *AllocateInRegion(RegionHeader *region, size_t size, size_t alignment)
+    {
+        auto begin = reinterpret_cast<uintptr_t>(region);  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        uintptr_t mem = (begin + region->top + alignment - 1) & ~(alignment - 1);
+        if (mem - begin > region->size || size > region->size - (mem - begin)) {
+            return nullptr;
+        }
+        region->top = mem - begin + size;
+        return reinterpret_cast<void *>(mem);  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    }
+
+    /// @brief Maps region of at least @param minSize bytes aligned by REGION_SIZE
+    RegionHeader *MapRegion(size_t minSize)
+    {
+        if (UNLIKELY(minSize > SIZE_MAX - 2U * REGION_SIZE)) {
+            return nullptr;
+        }
+        size_t size = (minSize + REGION_SIZE - 1) & ~(REGION_SIZE - 1);
+        // map more than needed and trim to get the alignment
+        size_t mapSize = size + REGION_SIZE;
+        void *raw = mmap(nullptr, mapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED) {
+            return nullptr;
+        }
+        auto rawAddr = reinterpret_cast<uintptr_t>(raw);  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        uintptr_t addr = (rawAddr + REGION_SIZE - 1) & ~(REGION_SIZE - 1);
+        if (addr != rawAddr) {
+            munmap(raw, addr - rawAddr);
+        }
+        size_t tail = rawAddr + mapSize - (addr + size);
+        if (tail != 0) {
+            munmap(reinterpret_cast<void *>(addr + size), tail);  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        }
+        void *mem = reinterpret_cast<void *>(addr);  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+#ifdef MADV_HUGEPAGE
+        if (useHugePages_) {
+            // it is only a hint, region stays usable if OS ignores it
+            madvise(mem, size, MADV_HUGEPAGE);
+        }
+#endif
+        return new (mem) RegionHeader {nullptr, size, sizeof(RegionHeader)};
+    }
+
+    static void UnmapRegion(RegionHeader *region)
+    {
+        munmap(region, region->size);
+    }
+
+    bool useHugePages_;
+    RegionHeader *first_ {nullptr};
+    RegionHeader *current_ {nullptr};
+    AllocatorCounters<> counters_;
+};
+
+#endif  // MEMORY_MANAGEMENT_BUMP_POINTER_ALLOCATOR_INCLUDE_GROWABLE_BUMP_POINTER_ALLOCATOR_H
@@ -0,0 +1,56 @@
+#ifndef MEMORY_MANAGEMENT_BUMP_POINTER_ALLOCATOR_INCLUDE_MONOTONIC_MEMORY_RESOURCE_H
+#define MEMORY_MANAGEMENT_BUMP_POINTER_ALLOCATOR_INCLUDE_MONOTONIC_MEMORY_RESOURCE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include "base/macros.h"
+
+/**
+ * Memory resource over BumpPointerAllocator or GrowableBumpPointerAllocator. Deallocation is a no-op like in
+ * std::pmr::monotonic_buffer_resource, memory is released all at once by Free, Rewind or ArenaScope of the allocator.
+ * Resource is not thread-safe because allocation uses the single-threaded path of the allocator.
+ */
+template <class BumpAllocator>
+class MonotonicMemoryResource final : public std::pmr::memory_resource {
+public:
+    explicit MonotonicMemoryResource(BumpAllocator &allocator) : allocator_(allocator) {}
+    ~MonotonicMemoryResource() override = default;
+    NO_COPY_SEMANTIC(MonotonicMemoryResource);
+    NO_MOVE_SEMANTIC(MonotonicMemoryResource);
+
+    BumpAllocator &GetAllocator() const
+    {
+        return allocator_;
+    }
+
+private:
+    void *do_allocate(size_t bytes, size_t alignment) override
+    {
+        if (alignment > BumpAllocator::MAX_ALIGNMENT) {
+            throw std::bad_alloc();
+        }
+        // zero size request should get a unique pointer too
+        void *mem = allocator_.template Allocate<uint8_t>(std::max<size_t>(bytes, 1U), alignment);
+        if (mem == nullptr) {
+            throw std::bad_alloc();
+        }
+        return mem;
+    }
+
+    void do_deallocate([[maybe_unused]] void *ptr, [[maybe_unused]] size_t bytes,
+                       [[maybe_unused]] size_t alignment) override
+    {
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    BumpAllocator &allocator_;
+};
+
+#endif  // MEMORY_MANAGEMENT_BUMP_POINTER_ALLOCATOR_INCLUDE_MONOTONIC_MEMORY_RESOURCE_H
@@ -1,9 +1,18 @@
 
 #include <gtest/gtest.h>
 #include <cstddef>
+#include <list>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 #include "memory_management/bump_pointer_allocator/include/bump_pointer_allocator.h"
+#include "memory_management/bump_pointer_allocator/include/growable_bump_pointer_allocator.h"
+#include "memory_management/bump_pointer_allocator/include/monotonic_memory_resource.h"
+#include "memory_management/common/include/stl_allocator.h"
 
-TEST(BumpAllocatorTest, DISABLED_TemplateAllocationTest)  // remove DISABLED_ prefix to use test
+TEST(BumpAllocatorTest, TemplateAllocationTest)
 {
     constexpr size_t MEMORY_POOL_SIZE = 4048U;
     BumpPointerAllocator<MEMORY_POOL_SIZE> allocator;
@@ -22,7 +31,7 @@ TEST(BumpAllocatorTest, DISABLED_TemplateAllocationTest)  // remove DISABLED_ pr
     ASSERT_EQ(allocator.Allocate<char>(0), nullptr);  // you can not allocate memory with 0 size
 }
 
-TEST(BumpAllocatorTest, DISABLED_AllocatorMemPoolOverflowTest)  // remove DISABLED_ prefix to use test
+TEST(BumpAllocatorTest, AllocatorMemPoolOverflowTest)
 {
     constexpr size_t MEMORY_POOL_SIZE = 64U;
     BumpPointerAllocator<MEMORY_POOL_SIZE> allocator;
@@ -38,4 +47,337 @@ TEST(BumpAllocatorTest, DISABLED_AllocatorMemPoolOverflowTest)  // remove DISABL
     ASSERT_EQ(allocator.Allocate<char>(5U), mem);
     allocator.Free();
     ASSERT_EQ(allocator.Allocate<size_t>(10U), nullptr);
-}
\ No newline at end of file
+}
+
+TEST(BumpAllocatorTest, TlabAllocationTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 1024U;
+    constexpr size_t CHUNK_SIZE = 64U;
+    BumpPointerAllocator<MEMORY_POOL_SIZE> allocator;
+    BumpPointerAllocator<MEMORY_POOL_SIZE>::Tlab tlab(allocator, CHUNK_SIZE);
+
+    ASSERT_EQ(tlab.Allocate<char>(0), nullptr);
+    auto *first = tlab.Allocate<size_t>(1U);
+    auto *second = tlab.Allocate<size_t>(1U);
+    ASSERT_NE(first, nullptr);
+    ASSERT_TRUE(allocator.VerifyPtr(first));
+    ASSERT_TRUE(allocator.VerifyPtr(second));
+    ASSERT_EQ(size_t(second) - size_t(first), sizeof(size_t));
+    ASSERT_EQ(tlab.GetFreeSize(), CHUNK_SIZE - 2U * sizeof(size_t));
+
+    // shared pool allocation goes after the chunk reserved by tlab
+    auto *shared = allocator.Allocate<char>(1U);
+    ASSERT_EQ(size_t(shared) - size_t(first), CHUNK_SIZE);
+
+    // allocation larger than a chunk is reserved from the pool directly
+    auto *big = tlab.Allocate<char>(CHUNK_SIZE * 2U);
+    ASSERT_NE(big, nullptr);
+    ASSERT_TRUE(allocator.VerifyPtr(big));
+    ASSERT_EQ(tlab.GetFreeSize(), CHUNK_SIZE - 2U * sizeof(size_t));
+
+    allocator.Free();
+    ASSERT_FALSE(allocator.VerifyPtr(first));
+    // tlab is refilled after Free, so it starts from the beginning of the pool
+    ASSERT_EQ(tlab.Allocate<size_t>(1U), first);
+}
+
+TEST(BumpAllocatorTest, TlabMemPoolOverflowTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 128U;
+    constexpr size_t CHUNK_SIZE = 64U;
+    BumpPointerAllocator<MEMORY_POOL_SIZE> allocator;
+    BumpPointerAllocator<MEMORY_POOL_SIZE>::Tlab tlab1(allocator, CHUNK_SIZE);
+    BumpPointerAllocator<MEMORY_POOL_SIZE>::Tlab tlab2(allocator, CHUNK_SIZE);
+
+    ASSERT_NE(tlab1.Allocate<char>(CHUNK_SIZE), nullptr);
+    ASSERT_NE(tlab2.Allocate<char>(CHUNK_SIZE), nullptr);
+    ASSERT_EQ(tlab1.Allocate<char>(1U), nullptr);
+    ASSERT_EQ(tlab2.Allocate<char>(1U), nullptr);
+    ASSERT_EQ(allocator.Allocate<char>(1U), nullptr);
+
+    allocator.Free();
+    ASSERT_NE(tlab1.Allocate<char>(1U), nullptr);
+}
+
+TEST(BumpAllocatorTest, TlabMultithreadingTest)
+{
+    constexpr size_t THREAD_COUNT = 8U;
+    constexpr size_t ALLOC_COUNT = 1000U;
+    constexpr size_t MEMORY_POOL_SIZE = THREAD_COUNT * ALLOC_COUNT * sizeof(size_t) * 2U;
+    auto allocator = std::make_unique<BumpPointerAllocator<MEMORY_POOL_SIZE>>();
+
+    std::vector<std::vector<size_t *>> allocated(THREAD_COUNT);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < THREAD_COUNT; i++) {
+        threads.emplace_back([&allocator, &ptrs = allocated[i], i]() {
+            BumpPointerAllocator<MEMORY_POOL_SIZE>::Tlab tlab(*allocator);
+            for (size_t j = 0; j < ALLOC_COUNT; j++) {
+                auto *mem = tlab.Allocate<size_t>(1U);
+                ASSERT_NE(mem, nullptr);
+                *mem = i;
+                ptrs.push_back(mem);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    for (size_t i = 0; i < THREAD_COUNT; i++) {
+        for (auto *mem : allocated[i]) {
+            ASSERT_TRUE(allocator->VerifyPtr(mem));
+            ASSERT_EQ(*mem, i);  // nobody else has written to this memory
+        }
+    }
+}
+
+TEST(BumpAllocatorTest, AlignedAllocationTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 8192U;
+    constexpr size_t SIMD_ALIGNMENT = 64U;
+    constexpr size_t PAGE_ALIGNMENT = 4096U;
+    BumpPointerAllocator<MEMORY_POOL_SIZE> allocator;
+
+    auto *chr = allocator.Allocate<char>(1U);
+    auto *num = allocator.Allocate<uint64_t>(1U);
+    ASSERT_NE(chr, nullptr);
+    ASSERT_EQ(size_t(num) % alignof(uint64_t), 0U);
+    ASSERT_EQ(size_t(num) - size_t(chr), alignof(uint64_t));
+
+    auto *simd = allocator.Allocate<float>(3U, SIMD_ALIGNMENT);
+    ASSERT_EQ(size_t(simd) % SIMD_ALIGNMENT, 0U);
+    auto *page = allocator.AllocateConcurrent<char>(1U, PAGE_ALIGNMENT);
+    ASSERT_NE(page, nullptr);
+    ASSERT_EQ(size_t(page) % PAGE_ALIGNMENT, 0U);
+    ASSERT_TRUE(allocator.VerifyPtr(page));
+
+    BumpPointerAllocator<MEMORY_POOL_SIZE>::Tlab tlab(allocator);
+    ASSERT_NE(tlab.Allocate<char>(1U), nullptr);
+    auto *tlabNum = tlab.Allocate<uint64_t>(1U);
+    ASSERT_EQ(size_t(tlabNum) % alignof(uint64_t), 0U);
+}
+
+TEST(BumpAllocatorTest, ConcurrentAllocationTest)
+{
+    constexpr size_t THREAD_COUNT = 8U;
+    constexpr size_t ALLOC_COUNT = 1000U;
+    constexpr size_t MEMORY_POOL_SIZE = THREAD_COUNT * ALLOC_COUNT * sizeof(size_t);
+    auto allocator = std::make_unique<BumpPointerAllocator<MEMORY_POOL_SIZE>>();
+
+    std::vector<std::vector<size_t *>> allocated(THREAD_COUNT);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < THREAD_COUNT; i++) {
+        threads.emplace_back([&allocator, &ptrs = allocated[i], i]() {
+            for (size_t j = 0; j < ALLOC_COUNT; j++) {
+                auto *mem = allocator->AllocateConcurrent<size_t>(1U);
+                ASSERT_NE(mem, nullptr);
+                *mem = i;
+                ptrs.push_back(mem);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    // pool is exhausted exactly and failed allocation does not move the pointer
+    ASSERT_EQ(allocator->AllocateConcurrent<size_t>(1U), nullptr);
+    ASSERT_EQ(allocator->AllocateConcurrent<char>(1U), nullptr);
+    for (size_t i = 0; i < THREAD_COUNT; i++) {
+        for (auto *mem : allocated[i]) {
+            ASSERT_TRUE(allocator->VerifyPtr(mem));
+            ASSERT_EQ(*mem, i);
+        }
+    }
+}
+
+TEST(BumpAllocatorTest, CheckpointRewindTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 256U;
+    BumpPointerAllocator<MEMORY_POOL_SIZE> allocator;
+
+    auto *alive = allocator.Allocate<size_t>(1U);
+    auto mark = allocator.Checkpoint();
+    auto *temp = allocator.Allocate<size_t>(4U);
+    ASSERT_TRUE(allocator.VerifyPtr(temp));
+
+    allocator.Rewind(mark);
+    ASSERT_TRUE(allocator.VerifyPtr(alive));
+    ASSERT_FALSE(allocator.VerifyPtr(temp));
+    ASSERT_EQ(allocator.Allocate<size_t>(1U), temp);
+}
+
+TEST(BumpAllocatorTest, ArenaScopeTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 256U;
+    using Allocator = BumpPointerAllocator<MEMORY_POOL_SIZE>;
+    Allocator allocator;
+    Allocator::Tlab tlab(allocator, sizeof(size_t) * 2U);
+
+    auto *alive = allocator.Allocate<size_t>(1U);
+    size_t *outer = nullptr;
+    size_t *inner = nullptr;
+    {
+        Allocator::ArenaScope outerScope(allocator);
+        outer = allocator.Allocate<size_t>(1U);
+        {
+            Allocator::ArenaScope innerScope(allocator);
+            inner = tlab.Allocate<size_t>(1U);
+            ASSERT_TRUE(allocator.VerifyPtr(inner));
+        }
+        ASSERT_TRUE(allocator.VerifyPtr(outer));
+        ASSERT_FALSE(allocator.VerifyPtr(inner));
+        // tlab chunk was released by the inner scope, so tlab takes a new one
+        ASSERT_EQ(tlab.Allocate<size_t>(1U), inner);
+    }
+    ASSERT_TRUE(allocator.VerifyPtr(alive));
+    ASSERT_FALSE(allocator.VerifyPtr(outer));
+    ASSERT_EQ(allocator.Allocate<size_t>(1U), outer);
+}
+
+TEST(BumpAllocatorTest, StatsTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 256U;
+    BumpPointerAllocator<MEMORY_POOL_SIZE> allocator;
+
+    ASSERT_NE(allocator.Allocate<uint64_t>(4U), nullptr);
+    ASSERT_EQ(allocator.Allocate<uint8_t>(MEMORY_POOL_SIZE), nullptr);
+    {
+        BumpPointerAllocator<MEMORY_POOL_SIZE>::Tlab tlab(allocator, 64U);
+        ASSERT_NE(tlab.Allocate<uint64_t>(2U), nullptr);
+    }
+    auto stats = allocator.GetStats();
+    ASSERT_EQ(stats.bytesReserved, MEMORY_POOL_SIZE);
+    ASSERT_EQ(stats.bytesUsed, 4U * sizeof(uint64_t) + 64U);
+    ASSERT_EQ(stats.bytesUsed + stats.bytesFree, MEMORY_POOL_SIZE);
+    ASSERT_EQ(stats.largestFreeBlock, stats.bytesFree);
+    ASSERT_EQ(stats.GetExternalFragmentation(), 0);
+    if constexpr (ALLOCATOR_COUNTERS_ENABLED) {
+        ASSERT_EQ(stats.allocationsCount, 2U);
+        ASSERT_EQ(stats.failedAllocationsCount, 1U);
+    }
+
+    allocator.Free();
+    stats = allocator.GetStats();
+    ASSERT_EQ(stats.bytesUsed, 0);
+    ASSERT_EQ(stats.bytesFree, MEMORY_POOL_SIZE);
+    if constexpr (ALLOCATOR_COUNTERS_ENABLED) {
+        ASSERT_EQ(stats.freesCount, 1U);
+    }
+}
+
+TEST(GrowableBumpAllocatorTest, RegionChainingTest)
+{
+    constexpr size_t REGION_SIZE = 4096U;
+    GrowableBumpPointerAllocator<REGION_SIZE> allocator;
+    ASSERT_EQ(allocator.Allocate<char>(0), nullptr);
+    ASSERT_EQ(allocator.GetRegionsCount(), 0U);
+
+    auto *first = allocator.Allocate<size_t>(1U);
+    auto *second = allocator.Allocate<size_t>(1U);
+    ASSERT_NE(first, nullptr);
+    ASSERT_EQ(size_t(second) - size_t(first), sizeof(size_t));
+    ASSERT_EQ(allocator.GetRegionsCount(), 1U);
+
+    // sizes close to SIZE_MAX fail before any region is mapped
+    size_t failed = allocator.GetStats().failedAllocationsCount;
+    ASSERT_EQ(allocator.Allocate<char>(SIZE_MAX - REGION_SIZE), nullptr);
+    ASSERT_EQ(allocator.Allocate<char>(allocator.MAX_ALLOCATION_SIZE + 1U), nullptr);
+    ASSERT_EQ(allocator.GetRegionsCount(), 1U);
+    if constexpr (ALLOCATOR_COUNTERS_ENABLED) {
+        ASSERT_EQ(allocator.GetStats().failedAllocationsCount, failed + 2U);
+        ASSERT_EQ(allocator.GetStats().allocationsCount, 2U);
+    }
+
+    // does not fit into the first region
+    auto *chained = allocator.Allocate<char>(REGION_SIZE - 4U * sizeof(size_t));
+    ASSERT_NE(chained, nullptr);
+    ASSERT_EQ(allocator.GetRegionsCount(), 2U);
+    // larger than a region
+    auto *large = allocator.Allocate<char>(REGION_SIZE * 3U);
+    ASSERT_NE(large, nullptr);
+    large[REGION_SIZE * 3U - 1U] = 1;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    ASSERT_EQ(allocator.GetRegionsCount(), 3U);
+
+    ASSERT_TRUE(allocator.VerifyPtr(first));
+    ASSERT_TRUE(allocator.VerifyPtr(second));
+    ASSERT_TRUE(allocator.VerifyPtr(chained));
+    ASSERT_TRUE(allocator.VerifyPtr(large + REGION_SIZE * 2U));  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    ASSERT_FALSE(allocator.VerifyPtr(large + REGION_SIZE * 3U));  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    size_t onStack = 0;
+    ASSERT_FALSE(allocator.VerifyPtr(&onStack));
+
+    allocator.Free();
+    ASSERT_EQ(allocator.GetRegionsCount(), 1U);
+    ASSERT_FALSE(allocator.VerifyPtr(first));
+    ASSERT_EQ(allocator.Allocate<size_t>(1U), first);
+}
+
+TEST(GrowableBumpAllocatorTest, HugePagesAlignedAllocationTest)
+{
+    constexpr size_t REGION_SIZE = 1U << 21U;
+    constexpr size_t PAGE_ALIGNMENT = 4096U;
+    GrowableBumpPointerAllocator<REGION_SIZE> allocator(true);
+
+    ASSERT_NE(allocator.Allocate<char>(1U), nullptr);
+    auto *page = allocator.Allocate<char>(PAGE_ALIGNMENT, PAGE_ALIGNMENT);
+    ASSERT_NE(page, nullptr);
+    ASSERT_EQ(size_t(page) % PAGE_ALIGNMENT, 0U);
+    ASSERT_TRUE(allocator.VerifyPtr(page));
+}
+
+TEST(BumpAllocatorTest, StlContainersTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 64U * 1024U;
+    using Allocator = BumpPointerAllocator<MEMORY_POOL_SIZE>;
+    using Resource = MonotonicMemoryResource<Allocator>;
+    auto allocator = std::make_unique<Allocator>();
+    Resource resource(*allocator);
+
+    std::vector<size_t, StlAllocator<size_t, Resource>> vector {StlAllocator<size_t, Resource>(resource)};
+    std::list<int, StlAllocator<int, Resource>> list {StlAllocator<int, Resource>(resource)};
+    constexpr size_t COUNT = 100U;
+    for (size_t i = 0; i < COUNT; i++) {
+        vector.push_back(i);
+        list.push_front(static_cast<int>(i));
+    }
+    ASSERT_TRUE(allocator->VerifyPtr(vector.data()));
+    ASSERT_TRUE(allocator->VerifyPtr(&list.front()));
+    ASSERT_EQ(list.front(), COUNT - 1U);
+
+    // allocator follows the container on move
+    auto moved = std::move(vector);
+    ASSERT_EQ(moved.get_allocator().GetResource(), &resource);
+    ASSERT_EQ(moved[COUNT - 1U], COUNT - 1U);
+
+    // deallocation is a no-op, the pool is released all at once
+    size_t used = allocator->GetStats().bytesUsed;
+    list.clear();
+    ASSERT_EQ(allocator->GetStats().bytesUsed, used);
+
+    std::pmr::vector<std::pmr::string> strings(&resource);
+    strings.emplace_back("string which does not fit into the small buffer of std::string");
+    ASSERT_TRUE(allocator->VerifyPtr(strings.front().data()));
+    ASSERT_THROW((void)resource.allocate(MEMORY_POOL_SIZE), std::bad_alloc);
+}
+
+TEST(GrowableBumpAllocatorTest, StlContainersTest)
+{
+    constexpr size_t REGION_SIZE = 4096U;
+    using Allocator = GrowableBumpPointerAllocator<REGION_SIZE>;
+    using Resource = MonotonicMemoryResource<Allocator>;
+    Allocator allocator;
+    Resource resource(allocator);
+
+    std::unordered_map<size_t, size_t, std::hash<size_t>, std::equal_to<>,
+                       StlAllocator<std::pair<const size_t, size_t>, Resource>>
+        map {StlAllocator<std::pair<const size_t, size_t>, Resource>(resource)};
+    constexpr size_t COUNT = 1000U;
+    for (size_t i = 0; i < COUNT; i++) {
+        map.emplace(i, i * i);
+    }
+    ASSERT_GT(allocator.GetRegionsCount(), 1U);
+    for (size_t i = 0; i < COUNT; i++) {
+        ASSERT_EQ(map.at(i), i * i);
+    }
+}
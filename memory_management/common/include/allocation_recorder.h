@@ -0,0 +1,227 @@
+#ifndef MEMORY_MANAGEMENT_COMMON_INCLUDE_ALLOCATION_RECORDER_H
+#define MEMORY_MANAGEMENT_COMMON_INCLUDE_ALLOCATION_RECORDER_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include "base/macros.h"
+
+// Allocators report their operations to the recorder only if PROJECT_ENABLE_ALLOCATION_TRACE is defined,
+// otherwise the hooks are empty. Recording itself is started and stopped at runtime.
+#ifdef PROJECT_ENABLE_ALLOCATION_TRACE
+inline constexpr bool ALLOCATION_TRACE_ENABLED = true;
+#else
+inline constexpr bool ALLOCATION_TRACE_ENABLED = false;
+#endif
+
+enum class TraceRecordOp : uint8_t { ALLOCATE, FREE };
+
+/// Record of the binary trace file
+struct TraceRecord {
+    uint64_t timestamp;  // ns since the recording start
+    uint64_t address;
+    uint64_t size;  // is 0 for FREE
+    uint16_t thread;
+    TraceRecordOp op;
+    uint8_t sizeClass;
+};
+static_assert(sizeof(TraceRecord) == 32U, "trace record layout is a part of the file format");
+
+/// Binary trace file is the header followed by records. Records of one thread are ordered by time.
+struct TraceFileHeader {
+    static constexpr std::array<char, 8U> MAGIC = {'M', 'M', 'T', 'R', 'A', 'C', 'E', '\0'};
+    static constexpr uint32_t VERSION = 2U;
+
+    std::array<char, 8U> magic {MAGIC};
+    uint32_t version {VERSION};
+    uint32_t recordSize {sizeof(TraceRecord)};
+};
+
+/**
+ * Process-wide recorder of allocator operations. Every thread writes records to its own ring buffer without
+ * locks, full buffer is flushed to the file under the file lock. Buffers of all threads are flushed by Stop and on
+ * thread exit. Start and Stop should be called when other threads do not allocate, otherwise operations done at
+ * that moment can be lost.
+ */
+class AllocationRecorder {
+public:
+    static constexpr uint8_t NO_SIZE_CLASS = UINT8_MAX;
+    static constexpr size_t BUFFER_CAPACITY = 4096U;
+
+    /// @returns false if the file can not be created or recording is already started
+    static bool Start(const char *path)
+    {
+        State &state = GetState();
+        std::lock_guard lock(state.lock);
+        if (state.file != nullptr) {
+            return false;
+        }
+        state.file = std::fopen(path, "wb");
+        if (state.file == nullptr) {
+            return false;
+        }
+        TraceFileHeader header;
+        std::fwrite(&header, sizeof(header), 1U, state.file);
+        // records which were left from the previous recording belong to the other file
+        for (ThreadBuffer *buffer = state.buffers; buffer != nullptr; buffer = buffer->next) {
+            buffer->head.store(buffer->tail.load(std::memory_order_acquire), std::memory_order_relaxed);
+        }
+        state.start = std::chrono::steady_clock::now();
+        state.recording.store(true, std::memory_order_release);
+        return true;
+    }
+
+    /// @brief Flushes buffers of all threads and closes the file
+    static void Stop()
+    {
+        State &state = GetState();
+        std::lock_guard lock(state.lock);
+        if (state.file == nullptr) {
+            return;
+        }
+        state.recording.store(false, std::memory_order_relaxed);
+        for (ThreadBuffer *buffer = state.buffers; buffer != nullptr; buffer = buffer->next) {
+            FlushUnlocked(state, buffer);
+        }
+        std::fclose(state.file);
+        state.file = nullptr;
+    }
+
+    static bool IsRecording()
+    {
+        return GetState().recording.load(std::memory_order_relaxed);
+    }
+
+    static void Record(TraceRecordOp op, const void *ptr, size_t size, uint8_t sizeClass)
+    {
+        State &state = GetState();
+        ThreadBuffer *buffer = GetThreadBuffer();
+        size_t tail = buffer->tail.load(std::memory_order_relaxed);
+        if (UNLIKELY(tail - buffer->head.load(std::memory_order_acquire) == BUFFER_CAPACITY)) {
+            std::lock_guard lock(state.lock);
+            FlushUnlocked(state, buffer);
+        }
+        auto timestamp = std::chrono::nanoseconds(std::chrono::steady_clock::now() - state.start).count();
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+        buffer->records[tail % BUFFER_CAPACITY] = {static_cast<uint64_t>(timestamp),
+                                                   reinterpret_cast<uintptr_t>(ptr),  // NOLINT
+                                                   static_cast<uint64_t>(size), buffer->thread, op, sizeClass};
+        buffer->tail.store(tail + 1U, std::memory_order_release);
+    }
+
+private:
+    /// Single producer (owner thread) single consumer (holder of the file lock) ring of records
+    struct ThreadBuffer {
+        std::array<TraceRecord, BUFFER_CAPACITY> records {};
+        std::atomic<size_t> head {0};
+        std::atomic<size_t> tail {0};
+        uint16_t thread {0};
+        ThreadBuffer *prev {nullptr};
+        ThreadBuffer *next {nullptr};
+    };
+
+    struct State {
+        std::mutex lock;  // protects the file and the list of buffers
+        std::FILE *file {nullptr};
+        std::atomic<bool> recording {false};
+        std::chrono::steady_clock::time_point start;
+        ThreadBuffer *buffers {nullptr};
+        uint16_t nextThread {0};
+    };
+
+    /// Registers buffer of the thread and flushes it on thread exit
+    class ThreadBufferHolder {
+    public:
+        ThreadBufferHolder() : buffer_(std::make_unique<ThreadBuffer>())
+        {
+            State &state = GetState();
+            std::lock_guard lock(state.lock);
+            buffer_->thread = state.nextThread++;
+            buffer_->next = state.buffers;
+            if (state.buffers != nullptr) {
+                state.buffers->prev = buffer_.get();
+            }
+            state.buffers = buffer_.get();
+        }
+        ~ThreadBufferHolder()
+        {
+            State &state = GetState();
+            std::lock_guard lock(state.lock);
+            FlushUnlocked(state, buffer_.get());
+            if (buffer_->prev != nullptr) {
+                buffer_->prev->next = buffer_->next;
+            } else {
+                state.buffers = buffer_->next;
+            }
+            if (buffer_->next != nullptr) {
+                buffer_->next->prev = buffer_->prev;
+            }
+        }
+        NO_COPY_SEMANTIC(ThreadBufferHolder);
+        NO_MOVE_SEMANTIC(ThreadBufferHolder);
+
+        ThreadBuffer *Get() const
+        {
+            return buffer_.get();
+        }
+
+    private:
+        std::unique_ptr<ThreadBuffer> buffer_;
+    };
+
+    static State &GetState()
+    {
+        static State state;
+        return state;
+    }
+
+    static ThreadBuffer *GetThreadBuffer()
+    {
+        thread_local ThreadBufferHolder holder;
+        return holder.Get();
+    }
+
+    static void FlushUnlocked(State &state, ThreadBuffer *buffer)
+    {
+        size_t head = buffer->head.load(std::memory_order_relaxed);
+        size_t tail = buffer->tail.load(std::memory_order_acquire);
+        if (state.file != nullptr) {
+            while (head != tail) {
+                size_t begin = head % BUFFER_CAPACITY;
+                size_t count = std::min(tail - head, BUFFER_CAPACITY - begin);
+                // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                std::fwrite(buffer->records.data() + begin, sizeof(TraceRecord), count, state.file);
+                head += count;
+            }
+        }
+        buffer->head.store(tail, std::memory_order_release);
+    }
+};
+
+/// @brief Hook of allocators, records allocation of @param size bytes at @param ptr if recording is on
+inline void TraceAllocate(const void *ptr, size_t size, size_t sizeClass = AllocationRecorder::NO_SIZE_CLASS)
+{
+    if constexpr (ALLOCATION_TRACE_ENABLED) {
+        if (ptr != nullptr && UNLIKELY(AllocationRecorder::IsRecording())) {
+            AllocationRecorder::Record(TraceRecordOp::ALLOCATE, ptr, size, static_cast<uint8_t>(sizeClass));
+        }
+    }
+}
+
+/// @brief Hook of allocators, records free of @param ptr if recording is on
+inline void TraceFree(const void *ptr)
+{
+    if constexpr (ALLOCATION_TRACE_ENABLED) {
+        if (ptr != nullptr && UNLIKELY(AllocationRecorder::IsRecording())) {
+            AllocationRecorder::Record(TraceRecordOp::FREE, ptr, 0, AllocationRecorder::NO_SIZE_CLASS);
+        }
+    }
+}
+
+#endif  // MEMORY_MANAGEMENT_COMMON_INCLUDE_ALLOCATION_RECORDER_H
@@ -0,0 +1,181 @@
+#ifndef MEMORY_MANAGEMENT_COMMON_INCLUDE_ALLOCATOR_STATS_H
+#define MEMORY_MANAGEMENT_COMMON_INCLUDE_ALLOCATOR_STATS_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+#include "base/macros.h"
+
+// Allocation counters are compiled in unless PROJECT_DISABLE_ALLOCATOR_STATS is defined.
+// Snapshot of the allocator state (GetStats) is always available, it costs nothing until it is called.
+#ifndef PROJECT_DISABLE_ALLOCATOR_STATS
+inline constexpr bool ALLOCATOR_COUNTERS_ENABLED = true;
+#else
+inline constexpr bool ALLOCATOR_COUNTERS_ENABLED = false;
+#endif
+
+/// Occupancy of one size class of a slab allocator
+struct SizeClassStats {
+    size_t slotSize {0};
+    size_t runsCount {0};
+    size_t slotsCount {0};
+    size_t freeSlotsCount {0};
+};
+
+/// Snapshot of an allocator state
+struct AllocatorStats {
+    static constexpr size_t HISTOGRAM_SIZE = sizeof(size_t) * 8U;
+
+    size_t bytesReserved {0};  // memory taken by the allocator from OS or heap
+    size_t bytesUsed {0};      // memory handed out to users including rounding and headers
+    size_t bytesFree {0};      // memory which can be handed out without taking more from OS
+    size_t largestFreeBlock {0};
+    size_t freeBlocksCount {0};
+    // count of free blocks by power of two size: i-th bucket keeps blocks of [2^i, 2^(i+1)) bytes
+    std::array<size_t, HISTOGRAM_SIZE> freeBlocksHistogram {};
+    std::vector<SizeClassStats> sizeClasses;
+
+    // counters are zero if they are compiled out
+    size_t allocationsCount {0};
+    size_t failedAllocationsCount {0};
+    size_t freesCount {0};
+
+    void AddFreeBlock(size_t size, size_t count = 1U)
+    {
+        if (size == 0 || count == 0) {
+            return;
+        }
+        bytesFree += size * count;
+        freeBlocksCount += count;
+        largestFreeBlock = std::max(largestFreeBlock, size);
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+        freeBlocksHistogram[HISTOGRAM_SIZE - 1U - static_cast<size_t>(__builtin_clzll(size))] += count;
+    }
+
+    /**
+     * @returns share of free memory which can not be used by the largest allocation: 0 when all free memory is one
+     * block, close to 1 when it is split into many small blocks
+     */
+    double GetExternalFragmentation() const
+    {
+        if (bytesFree == 0) {
+            return 0;
+        }
+        return 1.0 - static_cast<double>(largestFreeBlock) / static_cast<double>(bytesFree);
+    }
+};
+
+/// Counters of allocator operations. They are relaxed atomics, so they can be used by thread-safe allocators.
+template <bool ENABLED = ALLOCATOR_COUNTERS_ENABLED>
+class AllocatorCounters {
+public:
+    AllocatorCounters() = default;
+    ~AllocatorCounters() = default;
+    NO_COPY_SEMANTIC(AllocatorCounters);
+    NO_MOVE_SEMANTIC(AllocatorCounters);
+
+    void OnAllocate(bool success, size_t count = 1U)
+    {
+        if (success) {
+            allocations_.fetch_add(count, std::memory_order_relaxed);
+        } else {
+            failedAllocations_.fetch_add(count, std::memory_order_relaxed);
+        }
+    }
+
+    void OnFree(size_t count = 1U)
+    {
+        frees_.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    void Fill(AllocatorStats *stats) const
+    {
+        stats->allocationsCount = allocations_.load(std::memory_order_relaxed);
+        stats->failedAllocationsCount = failedAllocations_.load(std::memory_order_relaxed);
+        stats->freesCount = frees_.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<size_t> allocations_ {0};
+    std::atomic<size_t> failedAllocations_ {0};
+    std::atomic<size_t> frees_ {0};
+};
+
+template <>
+class AllocatorCounters<false> {
+public:
+    void OnAllocate([[maybe_unused]] bool success, [[maybe_unused]] size_t count = 1U) {}
+    void OnFree([[maybe_unused]] size_t count = 1U) {}
+    void Fill([[maybe_unused]] AllocatorStats *stats) const {}
+};
+
+/// Not atomic counters for thread local parts of allocators (Tlab, ThreadCache), they are flushed to the shared ones
+template <bool ENABLED = ALLOCATOR_COUNTERS_ENABLED>
+class LocalAllocatorCounters {
+public:
+    void OnAllocate(bool success)
+    {
+        (success ? allocations_ : failedAllocations_)++;
+    }
+
+    void OnFree()
+    {
+        frees_++;
+    }
+
+    void FlushTo(AllocatorCounters<ENABLED> *counters)
+    {
+        counters->OnAllocate(true, allocations_);
+        counters->OnAllocate(false, failedAllocations_);
+        counters->OnFree(frees_);
+        allocations_ = 0;
+        failedAllocations_ = 0;
+        frees_ = 0;
+    }
+
+private:
+    size_t allocations_ {0};
+    size_t failedAllocations_ {0};
+    size_t frees_ {0};
+};
+
+template <>
+class LocalAllocatorCounters<false> {
+public:
+    void OnAllocate([[maybe_unused]] bool success) {}
+    void OnFree() {}
+    void FlushTo([[maybe_unused]] AllocatorCounters<false> *counters) {}
+};
+
+/// @brief Writes @param stats to @param out as one line JSON object
+inline void DumpStats(const AllocatorStats &stats, std::ostream &out)
+{
+    out << "{\"bytes_reserved\":" << stats.bytesReserved << ",\"bytes_used\":" << stats.bytesUsed
+        << ",\"bytes_free\":" << stats.bytesFree << ",\"largest_free_block\":" << stats.largestFreeBlock
+        << ",\"free_blocks_count\":" << stats.freeBlocksCount
+        << ",\"external_fragmentation\":" << stats.GetExternalFragmentation()
+        << ",\"allocations\":" << stats.allocationsCount << ",\"failed_allocations\":" << stats.failedAllocationsCount
+        << ",\"frees\":" << stats.freesCount << ",\"free_blocks_histogram\":{";
+    bool first = true;
+    for (size_t i = 0; i < AllocatorStats::HISTOGRAM_SIZE; i++) {
+        if (stats.freeBlocksHistogram[i] == 0) {  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+            continue;
+        }
+        out << (first ? "" : ",") << "\"" << (size_t(1) << i) << "\":" << stats.freeBlocksHistogram[i];  // NOLINT
+        first = false;
+    }
+    out << "},\"size_classes\":[";
+    first = true;
+    for (const auto &sizeClass : stats.sizeClasses) {
+        out << (first ? "" : ",") << "{\"slot_size\":" << sizeClass.slotSize << ",\"runs\":" << sizeClass.runsCount
+            << ",\"slots\":" << sizeClass.slotsCount << ",\"free_slots\":" << sizeClass.freeSlotsCount << "}";
+        first = false;
+    }
+    out << "]}";
+}
+
+#endif  // MEMORY_MANAGEMENT_COMMON_INCLUDE_ALLOCATOR_STATS_H
@@ -0,0 +1,71 @@
+#ifndef MEMORY_MANAGEMENT_COMMON_INCLUDE_STL_ALLOCATOR_H
+#define MEMORY_MANAGEMENT_COMMON_INCLUDE_STL_ALLOCATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include "base/macros.h"
+
+/**
+ * Allocator which satisfies standard Allocator requirements, so containers can be placed on top of the project
+ * allocators. Memory is taken from @tparam Resource which is one of the project memory resources (std::pmr
+ * implementations). Resources are final classes, so calls are not virtual when they are done through the adaptor.
+ * Adaptor does not own the resource, copies of the adaptor use the same resource and it follows the container on
+ * copy, move and swap.
+ */
+template <class T, class Resource>
+class StlAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = std::false_type;
+
+    explicit StlAllocator(Resource &resource) noexcept : resource_(&resource) {}
+    template <class U>
+    // NOLINTNEXTLINE(google-explicit-constructor)
+    StlAllocator(const StlAllocator<U, Resource> &other) noexcept : resource_(other.GetResource())
+    {
+    }
+    ~StlAllocator() = default;
+    DEFAULT_COPY_SEMANTIC(StlAllocator);
+    DEFAULT_MOVE_SEMANTIC(StlAllocator);
+
+    /// @throws std::bad_alloc if the resource has no memory
+    T *allocate(size_t count)  // NOLINT(readability-identifier-naming)
+    {
+        if (count > SIZE_MAX / sizeof(T)) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T *>(resource_->allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T *ptr, size_t count) noexcept  // NOLINT(readability-identifier-naming)
+    {
+        resource_->deallocate(ptr, count * sizeof(T), alignof(T));
+    }
+
+    Resource *GetResource() const noexcept
+    {
+        return resource_;
+    }
+
+    template <class U>
+    bool operator==(const StlAllocator<U, Resource> &other) const noexcept
+    {
+        return resource_ == other.GetResource();
+    }
+
+    template <class U>
+    bool operator!=(const StlAllocator<U, Resource> &other) const noexcept
+    {
+        return resource_ != other.GetResource();
+    }
+
+private:
+    Resource *resource_;
+};
+
+#endif  // MEMORY_MANAGEMENT_COMMON_INCLUDE_STL_ALLOCATOR_H
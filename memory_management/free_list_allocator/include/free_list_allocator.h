@@ -1,47 +1,790 @@
 #ifndef MEMORY_MANAGEMENT_FREE_LIST_ALLOCATOR_INCLUDE_FREE_LIST_ALLOCATOR_H
 #define MEMORY_MANAGEMENT_FREE_LIST_ALLOCATOR_INCLUDE_FREE_LIST_ALLOCATOR_H
 
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
 #include <cstdint>
 #include <cstddef>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
 #include "base/macros.h"
+#include "memory_management/common/include/allocation_recorder.h"
+#include "memory_management/common/include/allocator_stats.h"
 
-template <size_t ONE_MEM_POOL_SIZE>
+/// Placement policy which is used to choose free block for allocation
+enum class FreeListPolicy {
+    FIRST_FIT,       // the first block which is large enough
+    NEXT_FIT,        // the first large enough block after the previously allocated one
+    BEST_FIT,        // the smallest block which is large enough, all free blocks are kept in a size ordered tree
+    SEGREGATED_FIT,  // small free blocks are bucketed by power of two size, large ones are kept in a size ordered tree
+};
+
+/**
+ * Thread-safe allocator of variable size blocks. Memory is taken from pools, every pool has its own lock.
+ * Each thread prefers a home pool which is chosen by the CPU the thread runs on, pools are bound to the NUMA node of
+ * the thread which created them. Other pools are used only when the home pool is exhausted, pools of the same node
+ * are tried first. New pool is created when all pools are exhausted.
+ */
+template <size_t ONE_MEM_POOL_SIZE, FreeListPolicy POLICY = FreeListPolicy::FIRST_FIT>
 class FreeListAllocator {
-    // here we recommend you to use class MemoryPool. Use new to allocate them from heap.
-    // remember, you can not use any containers with heap allocations
     template <size_t MEM_POOL_SIZE>
     class FreeListMemoryPool;
+    using Pool = FreeListMemoryPool<ONE_MEM_POOL_SIZE>;
+
+    // CPUs are mapped to home pools modulo this count
+    static constexpr size_t HOMES_COUNT = 64U;
+    // thread rechecks its CPU after this count of allocations, so it follows migrations of the scheduler
+    static constexpr size_t CPU_RECHECK_PERIOD = 1024U;
+    static constexpr size_t PAGE_SIZE = 4096U;
 
 public:
     FreeListAllocator() = default;
-    ~FreeListAllocator() = default;
+    ~FreeListAllocator()
+    {
+        Pool *pool = pools_.load(std::memory_order_relaxed);
+        while (pool != nullptr) {
+            Pool *next = pool->next.load(std::memory_order_relaxed);
+            DestroyPool(pool);
+            pool = next;
+        }
+    }
     NO_MOVE_SEMANTIC(FreeListAllocator);
     NO_COPY_SEMANTIC(FreeListAllocator);
 
+    /**
+     * @brief Allocates memory for @param count objects of type T from the home pool of the current thread.
+     * Other pools are used if the home pool has no suitable free block, new pool is created if all pools are
+     * exhausted.
+     * @returns pointer to allocated memory or nullptr if request does not fit into one pool
+     */
     template <class T = uint8_t>
-    T *Allocate([[maybe_unused]]size_t count)
+    T *Allocate(size_t count)
     {
-        // TODO(you): Add your implementation here...
-        return nullptr;
+        static_assert(alignof(T) <= Pool::ALIGNMENT, "type alignment is not supported");
+        if (count == 0 || count > ONE_MEM_POOL_SIZE / sizeof(T)) {
+            counters_.OnAllocate(false);
+            return nullptr;
+        }
+        size_t size = count * sizeof(T);
+        if (!Pool::CanFit(size)) {
+            counters_.OnAllocate(false);
+            return nullptr;
+        }
+        CpuLocation location = GetCpuLocation();
+        std::atomic<Pool *> &home = homes_[location.cpu % HOMES_COUNT];  // NOLINT(*-constant-array-index)
+        Pool *homePool = home.load(std::memory_order_acquire);
+        void *mem = homePool != nullptr ? AllocateFromPool(homePool, size) : nullptr;
+        if (UNLIKELY(mem == nullptr)) {
+            mem = AllocateSlowPath(&home, homePool, location.node, size);
+        }
+        counters_.OnAllocate(mem != nullptr);
+        TraceAllocate(mem, size);
+        return static_cast<T *>(mem);
     }
 
-    void Free([[maybe_unused]]void *ptr)
+    /**
+     * @brief Resizes allocation @param ptr to @param newCount objects. Block is grown in place by absorbing the
+     * free block after it and shrunk in place by splitting off its tail, otherwise the content is moved to a new
+     * block. nullptr @param ptr works as Allocate, zero @param newCount works as Free.
+     * @returns pointer to the resized memory or nullptr if there is no memory, then @param ptr stays valid
+     */
+    template <class T = uint8_t>
+    T *Reallocate(T *ptr, size_t newCount)
     {
-        // TODO(you): Add your implementation here...
+        static_assert(std::is_trivially_copyable_v<T>, "objects are moved by memcpy");
+        if (ptr == nullptr) {
+            return Allocate<T>(newCount);
+        }
+        if (newCount == 0) {
+            Free(ptr);
+            return nullptr;
+        }
+        Pool *pool = FindPool(ptr);
+        if (pool == nullptr || newCount > ONE_MEM_POOL_SIZE / sizeof(T) || !Pool::CanFit(newCount * sizeof(T))) {
+            counters_.OnAllocate(false);
+            return nullptr;
+        }
+        size_t size = newCount * sizeof(T);
+        size_t oldSize = 0;
+        {
+            std::lock_guard lock(pool->lock);
+            if (pool->Resize(ptr, size)) {
+                // replay sees in-place resize as free and allocation at the same address
+                TraceFree(ptr);
+                TraceAllocate(ptr, size);
+                return ptr;
+            }
+            oldSize = Pool::GetPayloadSize(ptr);
+        }
+        T *mem = Allocate<T>(newCount);
+        if (mem == nullptr) {
+            return nullptr;
+        }
+        std::memcpy(mem, ptr, std::min(size, oldSize));
+        Free(ptr);
+        return mem;
+    }
+
+    /**
+     * @brief Frees allocation @param ptr. Pointers which are not the start of a used block of this allocator are
+     * ignored: foreign pointers, pointers inside a block and double frees. The check reads only the boundary tags
+     * around ptr instead of walking the pool like VerifyPtr, so bytes inside a live payload which mimic a used block
+     * are not detected.
+     */
+    void Free(void *ptr)
+    {
+        Pool *pool = FindPool(ptr);
+        if (pool != nullptr) {
+            std::lock_guard lock(pool->lock);
+            if (UNLIKELY(!pool->IsUsedPayload(ptr))) {
+                return;
+            }
+            TraceFree(ptr);
+            pool->Free(ptr);
+            counters_.OnFree();
+        }
     }
 
     /**
      * @brief Method should check in @param ptr is pointer to mem from this allocator
      * @returns true if ptr is from this allocator
      */
-    bool VerifyPtr([[maybe_unused]] void *ptr)  // TODO(you): remove [[maybe_unused]]
+    bool VerifyPtr(void *ptr)
+    {
+        Pool *pool = FindPool(ptr);
+        if (pool == nullptr) {
+            return false;
+        }
+        std::lock_guard lock(pool->lock);
+        return pool->VerifyPtr(ptr);
+    }
+
+    /**
+     * @returns snapshot of the pools. Used bytes include block headers, size of a free block is the largest
+     * allocation it can serve.
+     */
+    AllocatorStats GetStats()
+    {
+        AllocatorStats stats;
+        for (Pool *pool = pools_.load(std::memory_order_acquire); pool != nullptr;
+             pool = pool->next.load(std::memory_order_acquire)) {
+            stats.bytesReserved += GetPoolMappingSize();
+            std::lock_guard lock(pool->lock);
+            pool->FillStats(&stats);
+        }
+        counters_.Fill(&stats);
+        return stats;
+    }
+
+private:
+    struct CpuLocation {
+        unsigned cpu;
+        unsigned node;
+    };
+
+    /**
+     * @returns CPU and NUMA node of the current thread. They are cached per thread and rechecked periodically,
+     * without getcpu all threads are spread over homes by thread id and are considered to be on node 0.
+     */
+    static CpuLocation GetCpuLocation()
+    {
+        thread_local CpuLocation location {0, 0};
+        thread_local size_t allocationsLeft = 0;
+        if (LIKELY(allocationsLeft-- != 0)) {
+            return location;
+        }
+        allocationsLeft = CPU_RECHECK_PERIOD;
+#if defined(__linux__) && defined(SYS_getcpu)
+        if (syscall(SYS_getcpu, &location.cpu, &location.node, nullptr) == 0) {
+            return location;
+        }
+#endif
+        location.cpu = static_cast<unsigned>(std::hash<std::thread::id> {}(std::this_thread::get_id()));
+        location.node = 0;
+        return location;
+    }
+
+    static void *AllocateFromPool(Pool *pool, size_t size)
+    {
+        std::lock_guard lock(pool->lock);
+        return pool->Allocate(size);
+    }
+
+    /**
+     * @brief Steals memory from other pools when @param homePool is exhausted, creates a new pool if there is
+     * nothing to steal. Home without pool adopts a local pool with free memory, it gets a new pool only when all
+     * local pools are exhausted, remote pools never become home.
+     */
+    void *AllocateSlowPath(std::atomic<Pool *> *home, Pool *homePool, unsigned node, size_t size)
+    {
+        // the first pass tries pools of the thread node, the second one tries remote pools
+        for (bool local : {true, false}) {
+            if (!local && homePool == nullptr) {
+                break;
+            }
+            for (Pool *pool = pools_.load(std::memory_order_acquire); pool != nullptr;
+                 pool = pool->next.load(std::memory_order_acquire)) {
+                if (pool == homePool || (pool->GetNode() == node) != local) {
+                    continue;
+                }
+                if (void *mem = AllocateFromPool(pool, size); mem != nullptr) {
+                    if (local) {
+                        // home moves to the pool with free memory, remote pools never become home
+                        home->store(pool, std::memory_order_release);
+                    }
+                    return mem;
+                }
+            }
+        }
+        Pool *pool = CreatePool(node);
+        if (pool == nullptr) {
+            return nullptr;
+        }
+        // pool is not published yet, so lock is not needed
+        void *mem = pool->Allocate(size);
+        {
+            std::lock_guard lock(poolsLock_);
+            if (tail_ == nullptr) {
+                pools_.store(pool, std::memory_order_release);
+            } else {
+                tail_->next.store(pool, std::memory_order_release);
+            }
+            tail_ = pool;
+        }
+        home->store(pool, std::memory_order_release);
+        return mem;
+    }
+
+    static constexpr size_t GetPoolMappingSize()
+    {
+        return (sizeof(Pool) + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
+    }
+
+    /// @brief Maps memory for a new pool and binds it to NUMA @param node
+    static Pool *CreatePool(unsigned node)
+    {
+        void *mem = mmap(nullptr, GetPoolMappingSize(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mem == MAP_FAILED) {
+            return nullptr;
+        }
+#if defined(__linux__) && defined(SYS_mbind)
+        // MPOL_PREFERRED from numaif.h, the call is done directly to not depend on libnuma. If the kernel does not
+        // support it, pages are still placed on the node of the first touch which is done by this thread.
+        constexpr int MPOL_PREFERRED_MODE = 1;
+        constexpr unsigned MAX_NODE = sizeof(unsigned long) * 8U;
+        if (node < MAX_NODE) {
+            unsigned long nodeMask = 1UL << node;
+            syscall(SYS_mbind, mem, GetPoolMappingSize(), MPOL_PREFERRED_MODE, &nodeMask, MAX_NODE, 0);
+        }
+#endif
+        return new (mem) Pool(node);
+    }
+
+    static void DestroyPool(Pool *pool)
+    {
+        pool->~Pool();
+        munmap(pool, GetPoolMappingSize());
+    }
+
+    Pool *FindPool(void *ptr) const
+    {
+        for (Pool *pool = pools_.load(std::memory_order_acquire); pool != nullptr;
+             pool = pool->next.load(std::memory_order_acquire)) {
+            if (pool->Contains(ptr)) {
+                return pool;
+            }
+        }
+        return nullptr;
+    }
+
+    std::atomic<Pool *> pools_ {nullptr};
+    std::array<std::atomic<Pool *>, HOMES_COUNT> homes_ {};
+    std::mutex poolsLock_;  // is taken to append a new pool
+    Pool *tail_ {nullptr};
+    AllocatorCounters<> counters_;
+};
+
+/**
+ * Pool of variable size blocks. Every block starts with a header which keeps its size and the size of the previous
+ * block (boundary tag), so neighbours of a freed block are found and coalesced in O(1). Free blocks keep links of
+ * the free list in their payload.
+ * Pool is not thread-safe, allocator takes its lock around every call.
+ */
+template <size_t ONE_MEM_POOL_SIZE, FreeListPolicy POLICY>
+template <size_t MEM_POOL_SIZE>
+class FreeListAllocator<ONE_MEM_POOL_SIZE, POLICY>::FreeListMemoryPool {
+    struct BlockHeader {
+        size_t prevSize;      // size of the previous block, 0 for the first block
+        size_t sizeAndFlags;  // size of the block including header, the lowest bit is set for used block
+    };
+
+    struct FreeBlock : BlockHeader {
+        FreeBlock *prev;
+        FreeBlock *next;
+    };
+
+    // free block of best fit or large free block of segregated fit, it is a node of treap ordered by (size, address)
+    struct TreeBlock : BlockHeader {
+        TreeBlock *left;
+        TreeBlock *right;
+    };
+
+    static constexpr size_t USED_BIT = 1U;
+    static constexpr size_t HEADER_SIZE = sizeof(BlockHeader);
+    static constexpr size_t MIN_BLOCK_SIZE = sizeof(FreeBlock);
+    static constexpr size_t BITS_IN_SIZE = sizeof(size_t) * 8U;
+    static constexpr bool USE_TREE = POLICY == FreeListPolicy::BEST_FIT || POLICY == FreeListPolicy::SEGREGATED_FIT;
+    static constexpr size_t BUCKETS_COUNT = POLICY == FreeListPolicy::SEGREGATED_FIT ? BITS_IN_SIZE : 1U;
+    static_assert(sizeof(TreeBlock) <= MIN_BLOCK_SIZE);
+
+public:
+    static constexpr size_t ALIGNMENT = alignof(std::max_align_t);
+    static constexpr size_t POOL_SIZE = MEM_POOL_SIZE & ~(ALIGNMENT - 1);
+    // free blocks of segregated fit starting from this size are indexed by tree instead of buckets
+    static constexpr size_t LARGE_BLOCK_SIZE = 1024U;
+
+    explicit FreeListMemoryPool(unsigned node) : node_(node)
+    {
+        if (POOL_SIZE >= MIN_BLOCK_SIZE) {
+            auto *block = BlockAt(0);
+            block->prevSize = 0;
+            SetBlock(block, POOL_SIZE, false);
+            InsertFree(block);
+        }
+    }
+    ~FreeListMemoryPool() = default;
+    NO_COPY_SEMANTIC(FreeListMemoryPool);
+    NO_MOVE_SEMANTIC(FreeListMemoryPool);
+
+    /// @returns true if allocation of @param size bytes can fit into an empty pool
+    static constexpr bool CanFit(size_t size)
+    {
+        return size <= POOL_SIZE && GetBlockSize(size) <= POOL_SIZE;
+    }
+
+    void *Allocate(size_t size)
+    {
+        size_t blockSize = GetBlockSize(size);
+        BlockHeader *block = FindFit(blockSize);
+        if (block == nullptr) {
+            return nullptr;
+        }
+        RemoveFree(block);
+        size_t freeSize = GetSize(block);
+        if (freeSize - blockSize >= MIN_BLOCK_SIZE) {
+            // split, the rest of the block stays free
+            SetBlock(block, blockSize, true);
+            BlockHeader *rest = NextBlock(block);
+            SetBlock(rest, freeSize - blockSize, false);
+            InsertFree(rest);
+            if constexpr (POLICY == FreeListPolicy::NEXT_FIT) {
+                rover_ = static_cast<FreeBlock *>(rest);
+            }
+        } else {
+            SetBlock(block, freeSize, true);
+        }
+        return GetPayload(block);
+    }
+
+    /**
+     * @brief Resizes used block of @param ptr in place to hold @param size bytes
+     * @returns false if the block can not grow because the next block is used or too small
+     */
+    bool Resize(void *ptr, size_t size)
+    {
+        BlockHeader *block = GetHeader(ptr);
+        assert(IsUsed(block));
+        size_t blockSize = GetBlockSize(size);
+        size_t curSize = GetSize(block);
+        BlockHeader *next = NextBlock(block);
+        size_t nextFreeSize = next != nullptr && !IsUsed(next) ? GetSize(next) : 0;
+        if (blockSize > curSize + nextFreeSize) {
+            return false;
+        }
+        size_t totalSize = curSize;
+        if (blockSize > curSize || (nextFreeSize != 0 && curSize - blockSize != 0)) {
+            // the next free block is absorbed: it is either needed for growth or merged with the cut tail
+            RemoveFree(next);
+            totalSize += nextFreeSize;
+        }
+        if (totalSize - blockSize >= MIN_BLOCK_SIZE) {
+            SetBlock(block, blockSize, true);
+            BlockHeader *rest = NextBlock(block);
+            SetBlock(rest, totalSize - blockSize, false);
+            InsertFree(rest);
+        } else {
+            SetBlock(block, totalSize, true);
+        }
+        return true;
+    }
+
+    /// @returns count of bytes which can be used by allocation @param ptr
+    static size_t GetPayloadSize(void *ptr)
     {
-        // TODO(you): Add your implementation here...
+        return GetSize(GetHeader(ptr)) - HEADER_SIZE;
+    }
+
+    void Free(void *ptr)
+    {
+        BlockHeader *block = GetHeader(ptr);
+        assert(IsUsed(block));
+        size_t size = GetSize(block);
+        BlockHeader *next = NextBlock(block);
+        if (next != nullptr && !IsUsed(next)) {
+            RemoveFree(next);
+            size += GetSize(next);
+        }
+        BlockHeader *prev = PrevBlock(block);
+        if (prev != nullptr && !IsUsed(prev)) {
+            RemoveFree(prev);
+            size += GetSize(prev);
+            block = prev;
+        }
+        SetBlock(block, size, false);
+        InsertFree(block);
+    }
+
+    /// @returns true if @param ptr points inside the pool memory
+    bool Contains(void *ptr) const
+    {
+        auto addr = reinterpret_cast<uintptr_t>(ptr);        // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        auto begin = reinterpret_cast<uintptr_t>(mem_.data());  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        return addr >= begin && addr < begin + POOL_SIZE;
+    }
+
+    /**
+     * @returns true if @param ptr looks like the payload of an allocated block: the block is used and the boundary
+     * tags of its neighbours agree with its size. It is O(1) unlike VerifyPtr which walks the pool.
+     */
+    bool IsUsedPayload(void *ptr)
+    {
+        size_t offset = GetOffset(ptr);
+        if (offset < HEADER_SIZE || offset % ALIGNMENT != 0) {
+            return false;
+        }
+        BlockHeader *block = GetHeader(ptr);
+        size_t blockOffset = offset - HEADER_SIZE;
+        size_t size = GetSize(block);
+        if (!IsUsed(block) || size < MIN_BLOCK_SIZE || size % ALIGNMENT != 0 || size > POOL_SIZE - blockOffset) {
+            return false;
+        }
+        BlockHeader *next = NextBlock(block);
+        if (next != nullptr && next->prevSize != size) {
+            return false;
+        }
+        if (blockOffset == 0) {
+            return block->prevSize == 0;
+        }
+        if (block->prevSize < MIN_BLOCK_SIZE || block->prevSize > blockOffset) {
+            return false;
+        }
+        return GetSize(PrevBlock(block)) == block->prevSize;
+    }
+
+    /// @returns true if @param ptr points to the payload of an allocated block
+    bool VerifyPtr(void *ptr)
+    {
+        for (BlockHeader *block = BlockAt(0); block != nullptr; block = NextBlock(block)) {
+            if (GetPayload(block) == ptr) {
+                return IsUsed(block);
+            }
+            if (GetPayload(block) > ptr) {
+                break;
+            }
+        }
         return false;
     }
 
+    /// @brief Adds used bytes and free blocks of the pool to @param stats
+    void FillStats(AllocatorStats *stats)
+    {
+        for (BlockHeader *block = BlockAt(0); block != nullptr; block = NextBlock(block)) {
+            if (IsUsed(block)) {
+                stats->bytesUsed += GetSize(block);
+            } else {
+                stats->AddFreeBlock(GetSize(block) - HEADER_SIZE);
+            }
+        }
+    }
+
+    /// @returns NUMA node the pool memory is bound to
+    unsigned GetNode() const
+    {
+        return node_;
+    }
+
+    std::atomic<FreeListMemoryPool *> next {nullptr};  // NOLINT(misc-non-private-member-variables-in-classes)
+    std::mutex lock;                                   // NOLINT(misc-non-private-member-variables-in-classes)
+
 private:
-    // TODO(you): Add your fields and methods here...
+    static constexpr size_t GetBlockSize(size_t size)
+    {
+        size_t blockSize = (size + HEADER_SIZE + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+        return std::max(blockSize, MIN_BLOCK_SIZE);
+    }
+
+    static size_t GetBucket(size_t size)
+    {
+        if constexpr (POLICY == FreeListPolicy::SEGREGATED_FIT) {
+            return BITS_IN_SIZE - 1U - static_cast<size_t>(__builtin_clzll(size));
+        } else {
+            return 0;
+        }
+    }
+
+    BlockHeader *FindFit(size_t size)
+    {
+        if constexpr (POLICY == FreeListPolicy::FIRST_FIT) {
+            return FindFirstFit(freeLists_[0], nullptr, size);
+        } else if constexpr (POLICY == FreeListPolicy::NEXT_FIT) {
+            FreeBlock *start = rover_ != nullptr ? rover_ : freeLists_[0];
+            FreeBlock *block = FindFirstFit(start, nullptr, size);
+            return block != nullptr ? block : FindFirstFit(freeLists_[0], start, size);
+        } else if constexpr (POLICY == FreeListPolicy::BEST_FIT) {
+            return TreeLowerBound(size);
+        } else {
+            if (size >= LARGE_BLOCK_SIZE) {
+                return TreeLowerBound(size);
+            }
+            size_t bucket = GetBucket(size);
+            // blocks of the own bucket can be smaller than size
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+            FreeBlock *block = FindFirstFit(freeLists_[bucket], nullptr, size);
+            if (block != nullptr) {
+                return block;
+            }
+            // any block of larger buckets fits, the smallest non-empty bucket is found by bitmap
+            uint64_t larger = nonEmptyBuckets_ & (~uint64_t(0) << (bucket + 1U));
+            if (larger == 0) {
+                return TreeLowerBound(size);
+            }
+            return freeLists_[__builtin_ctzll(larger)];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+        }
+    }
+
+    static FreeBlock *FindFirstFit(FreeBlock *begin, FreeBlock *end, size_t size)
+    {
+        for (FreeBlock *block = begin; block != end; block = block->next) {
+            if (GetSize(block) >= size) {
+                return block;
+            }
+        }
+        return nullptr;
+    }
+
+    static bool IsInTree(size_t size)
+    {
+        if constexpr (POLICY == FreeListPolicy::BEST_FIT) {
+            return true;
+        }
+        return USE_TREE && size >= LARGE_BLOCK_SIZE;
+    }
+
+    void InsertFree(BlockHeader *header)
+    {
+        size_t size = GetSize(header);
+        if (IsInTree(size)) {
+            TreeInsert(static_cast<TreeBlock *>(header));
+            return;
+        }
+        auto *block = static_cast<FreeBlock *>(header);
+        size_t bucket = GetBucket(size);
+        FreeBlock *&head = freeLists_[bucket];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+        block->prev = nullptr;
+        block->next = head;
+        if (head != nullptr) {
+            head->prev = block;
+        }
+        head = block;
+        nonEmptyBuckets_ |= uint64_t(1) << bucket;
+    }
+
+    void RemoveFree(BlockHeader *header)
+    {
+        size_t size = GetSize(header);
+        if (IsInTree(size)) {
+            TreeRemove(static_cast<TreeBlock *>(header));
+            return;
+        }
+        auto *block = static_cast<FreeBlock *>(header);
+        size_t bucket = GetBucket(size);
+        if constexpr (POLICY == FreeListPolicy::NEXT_FIT) {
+            if (rover_ == block) {
+                rover_ = block->next;
+            }
+        }
+        if (block->prev != nullptr) {
+            block->prev->next = block->next;
+        } else {
+            freeLists_[bucket] = block->next;  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+        }
+        if (block->next != nullptr) {
+            block->next->prev = block->prev;
+        }
+        if (freeLists_[bucket] == nullptr) {  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+            nonEmptyBuckets_ &= ~(uint64_t(1) << bucket);
+        }
+    }
+
+    /// @returns the smallest (and the lowest by address among equal) tree block of at least @param size bytes
+    TreeBlock *TreeLowerBound(size_t size) const
+    {
+        TreeBlock *best = nullptr;
+        for (TreeBlock *node = treeRoot_; node != nullptr;) {
+            if (GetSize(node) >= size) {
+                best = node;
+                node = node->left;
+            } else {
+                node = node->right;
+            }
+        }
+        return best;
+    }
+
+    void TreeInsert(TreeBlock *block)
+    {
+        block->left = nullptr;
+        block->right = nullptr;
+        TreeBlock *less = nullptr;
+        TreeBlock *notLess = nullptr;
+        TreeSplit(treeRoot_, block, false, &less, &notLess);
+        treeRoot_ = TreeMerge(TreeMerge(less, block), notLess);
+    }
+
+    void TreeRemove(TreeBlock *block)
+    {
+        TreeBlock *less = nullptr;
+        TreeBlock *notLess = nullptr;
+        TreeSplit(treeRoot_, block, false, &less, &notLess);
+        TreeBlock *equal = nullptr;
+        TreeBlock *greater = nullptr;
+        TreeSplit(notLess, block, true, &equal, &greater);
+        assert(equal == block && block->left == nullptr && block->right == nullptr);
+        treeRoot_ = TreeMerge(less, greater);
+    }
+
+    static bool TreeKeyLess(const TreeBlock *lhs, const TreeBlock *rhs)
+    {
+        return GetSize(lhs) < GetSize(rhs) || (GetSize(lhs) == GetSize(rhs) && lhs < rhs);
+    }
+
+    /// @returns heap priority of treap node, it is a hash of the address, so tree is balanced on average
+    static uint64_t TreePriority(const TreeBlock *block)
+    {
+        constexpr uint64_t HASH_MULTIPLIER = 0x9E3779B97F4A7C15ULL;
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        return reinterpret_cast<uintptr_t>(block) * HASH_MULTIPLIER;
+    }
+
+    /**
+     * @brief Splits @param tree into nodes less than @param key and the others. If @param keyToLeft is set, node
+     * equal to key goes to the left part.
+     */
+    static void TreeSplit(TreeBlock *tree, const TreeBlock *key, bool keyToLeft, TreeBlock **left, TreeBlock **right)
+    {
+        if (tree == nullptr) {
+            *left = nullptr;
+            *right = nullptr;
+            return;
+        }
+        bool toLeft = keyToLeft ? !TreeKeyLess(key, tree) : TreeKeyLess(tree, key);
+        if (toLeft) {
+            TreeSplit(tree->right, key, keyToLeft, &tree->right, right);
+            *left = tree;
+        } else {
+            TreeSplit(tree->left, key, keyToLeft, left, &tree->left);
+            *right = tree;
+        }
+    }
+
+    /// @brief Merges two treaps, all nodes of @param left should be less than nodes of @param right
+    static TreeBlock *TreeMerge(TreeBlock *left, TreeBlock *right)
+    {
+        if (left == nullptr) {
+            return right;
+        }
+        if (right == nullptr) {
+            return left;
+        }
+        if (TreePriority(left) > TreePriority(right)) {
+            left->right = TreeMerge(left->right, right);
+            return left;
+        }
+        right->left = TreeMerge(left, right->left);
+        return right;
+    }
+
+    static size_t GetSize(const BlockHeader *block)
+    {
+        return block->sizeAndFlags & ~USED_BIT;
+    }
+
+    static bool IsUsed(const BlockHeader *block)
+    {
+        return (block->sizeAndFlags & USED_BIT) != 0;
+    }
+
+    /// @brief Sets size of the block and updates boundary tag in the next block
+    void SetBlock(BlockHeader *block, size_t size, bool used)
+    {
+        block->sizeAndFlags = size | (used ? USED_BIT : 0U);
+        BlockHeader *next = NextBlock(block);
+        if (next != nullptr) {
+            next->prevSize = size;
+        }
+    }
+
+    BlockHeader *BlockAt(size_t offset)
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        return reinterpret_cast<BlockHeader *>(mem_.data() + offset);
+    }
+
+    size_t GetOffset(const void *ptr) const
+    {
+        return static_cast<size_t>(static_cast<const uint8_t *>(ptr) - mem_.data());
+    }
+
+    /// @returns the next block in memory or nullptr for the last block of the pool
+    BlockHeader *NextBlock(BlockHeader *block)
+    {
+        size_t offset = GetOffset(block) + GetSize(block);
+        return offset < POOL_SIZE ? BlockAt(offset) : nullptr;
+    }
+
+    /// @returns the previous block in memory or nullptr for the first block of the pool
+    BlockHeader *PrevBlock(BlockHeader *block)
+    {
+        size_t offset = GetOffset(block);
+        return offset != 0 ? BlockAt(offset - block->prevSize) : nullptr;
+    }
+
+    static void *GetPayload(BlockHeader *block)
+    {
+        return block + 1;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    static BlockHeader *GetHeader(void *ptr)
+    {
+        return static_cast<BlockHeader *>(ptr) - 1;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    unsigned node_;
+    std::array<FreeBlock *, BUCKETS_COUNT> freeLists_ {};
+    uint64_t nonEmptyBuckets_ {0};
+    FreeBlock *rover_ {nullptr};      // is used by next fit only
+    TreeBlock *treeRoot_ {nullptr};  // is used by best fit and segregated fit
+    // is not value-initialized, so pages of the pool are committed by the first touch on the node of the pool
+    alignas(ALIGNMENT) std::array<uint8_t, POOL_SIZE> mem_;
 };
 
-#endif  // MEMORY_MANAGEMENT_FREE_LIST_ALLOCATOR_INCLUDE_FREE_LIST_ALLOCATOR_H
\ No newline at end of file
+#endif  // MEMORY_MANAGEMENT_FREE_LIST_ALLOCATOR_INCLUDE_FREE_LIST_ALLOCATOR_H
@@ -0,0 +1,54 @@
+#ifndef MEMORY_MANAGEMENT_FREE_LIST_ALLOCATOR_INCLUDE_FREE_LIST_MEMORY_RESOURCE_H
+#define MEMORY_MANAGEMENT_FREE_LIST_ALLOCATOR_INCLUDE_FREE_LIST_MEMORY_RESOURCE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include "base/macros.h"
+
+/**
+ * Memory resource over FreeListAllocator. Blocks are aligned by alignof(std::max_align_t), over-aligned requests
+ * and requests larger than one pool throw std::bad_alloc. Resource is thread-safe like the allocator.
+ */
+template <class FreeListAllocatorType>
+class FreeListMemoryResource final : public std::pmr::memory_resource {
+public:
+    explicit FreeListMemoryResource(FreeListAllocatorType &allocator) : allocator_(allocator) {}
+    ~FreeListMemoryResource() override = default;
+    NO_COPY_SEMANTIC(FreeListMemoryResource);
+    NO_MOVE_SEMANTIC(FreeListMemoryResource);
+
+    FreeListAllocatorType &GetAllocator() const
+    {
+        return allocator_;
+    }
+
+private:
+    void *do_allocate(size_t bytes, size_t alignment) override
+    {
+        if (alignment > alignof(std::max_align_t)) {
+            throw std::bad_alloc();
+        }
+        void *mem = allocator_.template Allocate<uint8_t>(std::max<size_t>(bytes, 1U));
+        if (mem == nullptr) {
+            throw std::bad_alloc();
+        }
+        return mem;
+    }
+
+    void do_deallocate(void *ptr, [[maybe_unused]] size_t bytes, [[maybe_unused]] size_t alignment) override
+    {
+        allocator_.Free(ptr);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    FreeListAllocatorType &allocator_;
+};
+
+#endif  // MEMORY_MANAGEMENT_FREE_LIST_ALLOCATOR_INCLUDE_FREE_LIST_MEMORY_RESOURCE_H
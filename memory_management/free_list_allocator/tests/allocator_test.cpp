@@ -1,9 +1,18 @@
 
 #include <gtest/gtest.h>
+#include <sys/mman.h>
+#include <algorithm>
 #include <cstddef>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "memory_management/common/include/stl_allocator.h"
 #include "memory_management/free_list_allocator/include/free_list_allocator.h"
+#include "memory_management/free_list_allocator/include/free_list_memory_resource.h"
 
-TEST(FreeListAllocatorTest, DISABLED_TemplateAllocationTest)  // remove DISABLED_ prefix to use test
+TEST(FreeListAllocatorTest, TemplateAllocationTest)
 {
     constexpr size_t MEMORY_POOL_SIZE = 4048U;
     FreeListAllocator<MEMORY_POOL_SIZE> allocator;
@@ -29,10 +38,441 @@ TEST(FreeListAllocatorTest, DISABLED_TemplateAllocationTest)  // remove DISABLED
     allocator.Free(str2);
 }
 
-TEST(FreeListAllocatorTest, DISABLED_AllocatorMemPoolOverflowTest)  // remove DISABLED_ prefix to use test
+TEST(FreeListAllocatorTest, AllocatorMemPoolOverflowTest)
 {
     constexpr size_t MEMORY_POOL_SIZE = 8U;
     FreeListAllocator<MEMORY_POOL_SIZE> allocator;
     auto *mem = allocator.Allocate<size_t>(1U);
     ASSERT_EQ(mem, nullptr);
-}
\ No newline at end of file
+}
+
+TEST(FreeListAllocatorTest, InvalidFreeTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 1024U;
+    constexpr size_t BLOCK_SIZE = 64U;
+    FreeListAllocator<MEMORY_POOL_SIZE> allocator;
+    auto *first = allocator.Allocate<char>(BLOCK_SIZE);
+    auto *second = allocator.Allocate<char>(BLOCK_SIZE);
+    ASSERT_NE(second, nullptr);
+    size_t usedBytes = allocator.GetStats().bytesUsed;
+
+    // pointers inside a block and unaligned ones are ignored
+    allocator.Free(first + 1);                          // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    allocator.Free(first + alignof(std::max_align_t));  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    ASSERT_EQ(allocator.GetStats().bytesUsed, usedBytes);
+    ASSERT_TRUE(allocator.VerifyPtr(first));
+
+    // double free does not corrupt the free list
+    allocator.Free(first);
+    allocator.Free(first);
+    ASSERT_FALSE(allocator.VerifyPtr(first));
+    ASSERT_TRUE(allocator.VerifyPtr(second));
+    ASSERT_EQ(allocator.Allocate<char>(BLOCK_SIZE), first);
+    ASSERT_NE(allocator.Allocate<char>(BLOCK_SIZE), first);
+}
+
+template <FreeListPolicy POLICY>
+static void CheckCoalescing()
+{
+    constexpr size_t MEMORY_POOL_SIZE = 1024U;
+    constexpr size_t BLOCK_SIZE = 64U;
+    FreeListAllocator<MEMORY_POOL_SIZE, POLICY> allocator;
+
+    auto *first = allocator.template Allocate<char>(BLOCK_SIZE);
+    auto *second = allocator.template Allocate<char>(BLOCK_SIZE);
+    auto *third = allocator.template Allocate<char>(BLOCK_SIZE);
+    auto *guard = allocator.template Allocate<char>(BLOCK_SIZE);
+    ASSERT_NE(guard, nullptr);
+    ASSERT_EQ(size_t(third) % alignof(std::max_align_t), 0U);
+
+    allocator.Free(first);
+    allocator.Free(third);
+    ASSERT_FALSE(allocator.VerifyPtr(third));
+    ASSERT_TRUE(allocator.VerifyPtr(second));
+    // middle block is merged with both neighbours, so the hole can hold all three blocks
+    allocator.Free(second);
+    auto *merged = allocator.template Allocate<char>(BLOCK_SIZE * 3U);
+    ASSERT_NE(merged, nullptr);
+    if (POLICY != FreeListPolicy::NEXT_FIT) {
+        // next fit continues from the tail of the pool
+        ASSERT_EQ(merged, first);
+    }
+    ASSERT_TRUE(allocator.VerifyPtr(merged));
+
+    allocator.Free(merged);
+    allocator.Free(guard);
+    // everything is merged back into one block
+    auto *whole = allocator.template Allocate<char>(MEMORY_POOL_SIZE - 2U * sizeof(size_t));
+    ASSERT_EQ(whole, first);
+    allocator.Free(whole);
+}
+
+TEST(FreeListAllocatorTest, FirstFitCoalescingTest)
+{
+    CheckCoalescing<FreeListPolicy::FIRST_FIT>();
+}
+
+TEST(FreeListAllocatorTest, NextFitCoalescingTest)
+{
+    CheckCoalescing<FreeListPolicy::NEXT_FIT>();
+}
+
+TEST(FreeListAllocatorTest, BestFitCoalescingTest)
+{
+    CheckCoalescing<FreeListPolicy::BEST_FIT>();
+}
+
+TEST(FreeListAllocatorTest, SegregatedFitCoalescingTest)
+{
+    CheckCoalescing<FreeListPolicy::SEGREGATED_FIT>();
+}
+
+template <FreeListPolicy POLICY>
+static void CheckReallocation()
+{
+    constexpr size_t MEMORY_POOL_SIZE = 1024U;
+    constexpr size_t COUNT = 8U;
+    FreeListAllocator<MEMORY_POOL_SIZE, POLICY> allocator;
+
+    auto *buffer = allocator.template Reallocate<size_t>(nullptr, COUNT);
+    auto *neighbour = allocator.template Allocate<size_t>(COUNT);
+    auto *guard = allocator.template Allocate<size_t>(COUNT);
+    ASSERT_NE(guard, nullptr);
+    for (size_t i = 0; i < COUNT; i++) {
+        buffer[i] = i;
+    }
+
+    // the neighbour is used, so the buffer is moved
+    auto *moved = allocator.Reallocate(buffer, COUNT * 2U);
+    ASSERT_NE(moved, buffer);
+    ASSERT_FALSE(allocator.VerifyPtr(buffer));
+    for (size_t i = 0; i < COUNT; i++) {
+        ASSERT_EQ(moved[i], i);
+    }
+
+    // the neighbour is free, so it is absorbed
+    allocator.Free(moved);
+    buffer = allocator.template Allocate<size_t>(COUNT);
+    ASSERT_NE(buffer, nullptr);
+    allocator.Free(neighbour);
+    auto *grown = allocator.Reallocate(buffer, COUNT * 2U);
+    ASSERT_TRUE(allocator.VerifyPtr(grown));
+    if (POLICY != FreeListPolicy::NEXT_FIT) {
+        // next fit places the buffer at the rover, its neighbour is not the freed block
+        ASSERT_EQ(grown, buffer);
+    }
+
+    // the tail of the shrunk block is returned to the free blocks
+    size_t usedBefore = allocator.GetStats().bytesUsed;
+    auto *shrunk = allocator.Reallocate(grown, 1U);
+    ASSERT_EQ(shrunk, grown);
+    ASSERT_LT(allocator.GetStats().bytesUsed, usedBefore);
+    ASSERT_TRUE(allocator.VerifyPtr(shrunk));
+    ASSERT_EQ(allocator.Reallocate(shrunk, MEMORY_POOL_SIZE), nullptr);
+    ASSERT_TRUE(allocator.VerifyPtr(shrunk));
+
+    ASSERT_EQ(allocator.Reallocate(shrunk, 0U), nullptr);
+    ASSERT_FALSE(allocator.VerifyPtr(shrunk));
+    allocator.Free(guard);
+}
+
+TEST(FreeListAllocatorTest, FirstFitReallocationTest)
+{
+    CheckReallocation<FreeListPolicy::FIRST_FIT>();
+}
+
+TEST(FreeListAllocatorTest, NextFitReallocationTest)
+{
+    CheckReallocation<FreeListPolicy::NEXT_FIT>();
+}
+
+TEST(FreeListAllocatorTest, SegregatedFitReallocationTest)
+{
+    CheckReallocation<FreeListPolicy::SEGREGATED_FIT>();
+}
+
+TEST(FreeListAllocatorTest, BestFitPlacementTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 4096U;
+    constexpr size_t SMALL_SIZE = 64U;
+    constexpr size_t LARGE_SIZE = 256U;
+    FreeListAllocator<MEMORY_POOL_SIZE, FreeListPolicy::BEST_FIT> allocator;
+
+    auto *large = allocator.Allocate<char>(LARGE_SIZE);
+    auto *guard1 = allocator.Allocate<char>(1U);
+    auto *small = allocator.Allocate<char>(SMALL_SIZE);
+    auto *guard2 = allocator.Allocate<char>(1U);
+    allocator.Free(large);
+    allocator.Free(small);
+
+    // the smallest hole is used even though the larger one comes first
+    ASSERT_EQ(allocator.Allocate<char>(SMALL_SIZE), small);
+    ASSERT_EQ(allocator.Allocate<char>(SMALL_SIZE), large);
+    allocator.Free(guard1);
+    allocator.Free(guard2);
+}
+
+TEST(FreeListAllocatorTest, SegregatedFitPlacementTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 1U << 16U;
+    constexpr size_t SMALL_SIZE = 16U;
+    constexpr size_t LARGE_SIZE = MEMORY_POOL_SIZE / 2U;
+    FreeListAllocator<MEMORY_POOL_SIZE, FreeListPolicy::SEGREGATED_FIT> allocator;
+
+    std::vector<char *> small;
+    for (size_t i = 0; i < 16U; i++) {
+        small.push_back(allocator.Allocate<char>(SMALL_SIZE));
+        ASSERT_NE(small.back(), nullptr);
+    }
+    auto *large = allocator.Allocate<char>(LARGE_SIZE);
+    ASSERT_NE(large, nullptr);
+    for (size_t i = 0; i < small.size(); i += 2U) {
+        allocator.Free(small[i]);
+    }
+    // small request is served from a small hole, not from the tail of the pool
+    auto *reused = allocator.Allocate<char>(SMALL_SIZE);
+    ASSERT_TRUE(std::find(small.begin(), small.end(), reused) != small.end());
+    ASSERT_TRUE(allocator.VerifyPtr(large));
+    allocator.Free(large);
+}
+
+TEST(FreeListAllocatorTest, LargeBlocksBestFitTest)
+{
+    using Allocator = FreeListAllocator<1U << 20U, FreeListPolicy::SEGREGATED_FIT>;
+    constexpr size_t LARGE_SIZE = 4096U;
+    constexpr size_t HOLES_COUNT = 64U;
+    Allocator allocator;
+
+    // holes of different large sizes divided by small used blocks
+    std::vector<char *> holes;
+    std::vector<char *> guards;
+    for (size_t i = 0; i < HOLES_COUNT; i++) {
+        holes.push_back(allocator.Allocate<char>(LARGE_SIZE + (HOLES_COUNT - i) * 64U));
+        guards.push_back(allocator.Allocate<char>(1U));
+        ASSERT_NE(guards.back(), nullptr);
+    }
+    for (auto *hole : holes) {
+        allocator.Free(hole);
+    }
+    // the best fitting hole is the last one, although all of them are large enough
+    ASSERT_EQ(allocator.Allocate<char>(LARGE_SIZE), holes.back());
+    ASSERT_EQ(allocator.Allocate<char>(LARGE_SIZE + 64U), holes[HOLES_COUNT - 2U]);
+    // small request takes a large block only if there are no small ones
+    auto *small = allocator.Allocate<char>(64U);
+    ASSERT_NE(small, nullptr);
+    ASSERT_TRUE(allocator.VerifyPtr(small));
+}
+
+template <FreeListPolicy POLICY>
+static void CheckRandomAllocations()
+{
+    constexpr size_t MEMORY_POOL_SIZE = 1U << 16U;
+    constexpr size_t ITERATIONS = 5000U;
+    constexpr size_t MAX_LIVE = 64U;
+    FreeListAllocator<MEMORY_POOL_SIZE, POLICY> allocator;
+    std::mt19937 gen(POLICY == FreeListPolicy::SEGREGATED_FIT ? 1U : 2U);
+    std::uniform_int_distribution<size_t> smallSize(1U, 64U);
+    std::uniform_int_distribution<size_t> largeSize(512U, 8192U);
+
+    std::vector<std::pair<uint8_t *, size_t>> live;
+    for (size_t i = 0; i < ITERATIONS; i++) {
+        if (live.size() == MAX_LIVE || (!live.empty() && gen() % 2U == 0)) {
+            size_t idx = gen() % live.size();
+            auto [mem, size] = live[idx];
+            // nobody has overwritten the block while it was alive
+            ASSERT_TRUE(allocator.VerifyPtr(mem));
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            ASSERT_EQ(size_t(std::count(mem, mem + size, uint8_t(size))), size);
+            allocator.Free(mem);
+            live[idx] = live.back();
+            live.pop_back();
+            continue;
+        }
+        size_t size = gen() % 4U == 0 ? largeSize(gen) : smallSize(gen);
+        auto *mem = allocator.template Allocate<uint8_t>(size);
+        ASSERT_NE(mem, nullptr);
+        std::fill(mem, mem + size, uint8_t(size));  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        live.emplace_back(mem, size);
+    }
+    for (auto [mem, size] : live) {
+        allocator.Free(mem);
+    }
+}
+
+TEST(FreeListAllocatorTest, RandomAllocationsTest)
+{
+    CheckRandomAllocations<FreeListPolicy::FIRST_FIT>();
+    CheckRandomAllocations<FreeListPolicy::NEXT_FIT>();
+    CheckRandomAllocations<FreeListPolicy::BEST_FIT>();
+    CheckRandomAllocations<FreeListPolicy::SEGREGATED_FIT>();
+}
+
+TEST(FreeListAllocatorTest, MultithreadingTest)
+{
+    constexpr size_t THREAD_COUNT = 8U;
+    constexpr size_t ALLOC_COUNT = 300U;
+    constexpr size_t MEMORY_POOL_SIZE = 8192U;
+    using Allocator = FreeListAllocator<MEMORY_POOL_SIZE, FreeListPolicy::SEGREGATED_FIT>;
+    Allocator allocator;
+
+    std::vector<std::vector<size_t *>> allocated(THREAD_COUNT);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < THREAD_COUNT; i++) {
+        threads.emplace_back([&allocator, &ptrs = allocated[i], i]() {
+            std::mt19937 gen(i);
+            for (size_t j = 0; j < ALLOC_COUNT; j++) {
+                size_t count = 1U + gen() % 16U;
+                auto *mem = allocator.Allocate<size_t>(count);
+                ASSERT_NE(mem, nullptr);
+                std::fill(mem, mem + count, i);
+                ptrs.push_back(mem);
+                if (j % 3U == 0) {
+                    // some blocks are freed and reused right away
+                    size_t victim = gen() % ptrs.size();
+                    allocator.Free(ptrs[victim]);
+                    ptrs[victim] = nullptr;
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    ASSERT_GT(allocator.GetStats().bytesReserved, MEMORY_POOL_SIZE);
+
+    // every thread frees blocks allocated by its neighbour
+    threads.clear();
+    for (size_t i = 0; i < THREAD_COUNT; i++) {
+        size_t owner = (i + 1U) % THREAD_COUNT;
+        threads.emplace_back([&allocator, &ptrs = allocated[owner], owner]() {
+            for (auto *mem : ptrs) {
+                ASSERT_TRUE(mem == nullptr || *mem == owner);
+                allocator.Free(mem);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    auto stats = allocator.GetStats();
+    ASSERT_EQ(stats.bytesUsed, 0);
+}
+
+TEST(FreeListAllocatorTest, HomeAdoptsLocalPoolTest)
+{
+    constexpr size_t THREAD_COUNT = 8U;
+    constexpr size_t MEMORY_POOL_SIZE = 8192U;
+    FreeListAllocator<MEMORY_POOL_SIZE> allocator;
+    ASSERT_NE(allocator.Allocate<size_t>(1U), nullptr);
+    size_t reserved = allocator.GetStats().bytesReserved;
+
+    // threads can run on other CPUs, their empty homes take the pool with free memory instead of a new one
+    for (size_t i = 0; i < THREAD_COUNT; i++) {
+        std::thread([&allocator]() { ASSERT_NE(allocator.Allocate<size_t>(1U), nullptr); }).join();
+    }
+    ASSERT_EQ(allocator.GetStats().bytesReserved, reserved);
+}
+
+TEST(FreeListAllocatorTest, LazyCommitTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 1024U * 1024U;
+    constexpr size_t PAGE_SIZE = 4096U;
+    FreeListAllocator<MEMORY_POOL_SIZE> allocator;
+    auto *mem = allocator.Allocate<uint8_t>(64U);
+    ASSERT_NE(mem, nullptr);
+
+    // pages of the pool are not touched until they are allocated
+    auto begin = reinterpret_cast<uintptr_t>(mem) & ~(PAGE_SIZE - 1U);  // NOLINT(*-reinterpret-cast)
+    std::vector<unsigned char> resident(MEMORY_POOL_SIZE / PAGE_SIZE);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast, performance-no-int-to-ptr)
+    ASSERT_EQ(mincore(reinterpret_cast<void *>(begin), MEMORY_POOL_SIZE - PAGE_SIZE, resident.data()), 0);
+    size_t residentPages = 0;
+    for (unsigned char page : resident) {
+        if ((page & 1U) != 0) {
+            residentPages++;
+        }
+    }
+    ASSERT_LE(residentPages, 2U);
+    allocator.Free(mem);
+}
+
+TEST(FreeListAllocatorTest, StatsTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 4096U;
+    FreeListAllocator<MEMORY_POOL_SIZE> allocator;
+
+    std::vector<uint8_t *> blocks;
+    for (size_t i = 0; i < 8U; i++) {
+        blocks.push_back(allocator.Allocate<uint8_t>(100U));
+    }
+    ASSERT_EQ(allocator.Allocate<uint8_t>(MEMORY_POOL_SIZE * 2U), nullptr);
+    // every second block is freed, so free memory is split into holes
+    for (size_t i = 0; i < blocks.size(); i += 2U) {
+        allocator.Free(blocks[i]);
+    }
+
+    auto stats = allocator.GetStats();
+    ASSERT_GE(stats.bytesReserved, MEMORY_POOL_SIZE);
+    ASSERT_GE(stats.bytesUsed, 4U * 100U);
+    ASSERT_EQ(stats.freeBlocksCount, 5U);
+    ASSERT_GT(stats.largestFreeBlock, 100U);
+    ASSERT_LT(stats.largestFreeBlock, stats.bytesFree);
+    ASSERT_GT(stats.GetExternalFragmentation(), 0);
+    if constexpr (ALLOCATOR_COUNTERS_ENABLED) {
+        ASSERT_EQ(stats.allocationsCount, 8U);
+        ASSERT_EQ(stats.failedAllocationsCount, 1U);
+        ASSERT_EQ(stats.freesCount, 4U);
+    }
+
+    std::ostringstream out;
+    DumpStats(stats, out);
+    std::string dump = out.str();
+    ASSERT_EQ(dump.front(), '{');
+    ASSERT_EQ(dump.back(), '}');
+    ASSERT_NE(dump.find("\"free_blocks_count\":5"), std::string::npos);
+    ASSERT_NE(dump.find("\"free_blocks_histogram\":{\"64\":4"), std::string::npos);
+
+    for (size_t i = 1; i < blocks.size(); i += 2U) {
+        allocator.Free(blocks[i]);
+    }
+    stats = allocator.GetStats();
+    ASSERT_EQ(stats.bytesUsed, 0);
+    ASSERT_EQ(stats.freeBlocksCount, 1U);
+    ASSERT_EQ(stats.GetExternalFragmentation(), 0);
+}
+
+TEST(FreeListAllocatorTest, StlContainersTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 16U * 1024U;
+    using Allocator = FreeListAllocator<MEMORY_POOL_SIZE, FreeListPolicy::SEGREGATED_FIT>;
+    using Resource = FreeListMemoryResource<Allocator>;
+    Allocator allocator;
+    Resource resource(allocator);
+
+    {
+        std::vector<size_t, StlAllocator<size_t, Resource>> vector {StlAllocator<size_t, Resource>(resource)};
+        std::unordered_map<size_t, size_t, std::hash<size_t>, std::equal_to<>,
+                           StlAllocator<std::pair<const size_t, size_t>, Resource>>
+            map {StlAllocator<std::pair<const size_t, size_t>, Resource>(resource)};
+        constexpr size_t COUNT = 500U;
+        for (size_t i = 0; i < COUNT; i++) {
+            vector.push_back(i);
+            map.emplace(i, i);
+        }
+        ASSERT_TRUE(allocator.VerifyPtr(vector.data()));
+        ASSERT_EQ(map.at(COUNT - 1U), COUNT - 1U);
+
+        // containers with allocators of different resources are not equal
+        Allocator otherAllocator;
+        Resource otherResource(otherAllocator);
+        std::vector<size_t, StlAllocator<size_t, Resource>> other {StlAllocator<size_t, Resource>(otherResource)};
+        ASSERT_NE(vector.get_allocator(), other.get_allocator());
+        other = vector;
+        ASSERT_EQ(vector.get_allocator(), other.get_allocator());
+    }
+    ASSERT_EQ(allocator.GetStats().bytesUsed, 0);
+
+    std::pmr::vector<int> vector({1, 2, 3}, &resource);
+    ASSERT_TRUE(allocator.VerifyPtr(vector.data()));
+    ASSERT_THROW((void)resource.allocate(1U, alignof(std::max_align_t) * 2U), std::bad_alloc);
+}
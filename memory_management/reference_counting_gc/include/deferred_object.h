@@ -0,0 +1,469 @@
+#ifndef MEMORY_MANAGEMENT_REFERECNCE_COUNTING_GC_INCLUDE_DEFERRED_OBJECT_H
+#define MEMORY_MANAGEMENT_REFERECNCE_COUNTING_GC_INCLUDE_DEFERRED_OBJECT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "base/macros.h"
+
+// Deferred and coalesced reference counting (Levanoni, Petrank "An On-the-Fly Reference-Counting Garbage Collector
+// for Java"). Only references from heap objects (DeferredField) are counted, references from the stack
+// (DeferredObject) are registered in the list of roots and are not counted. Writes to fields are not applied to
+// counts immediately: the first write to a field since the last safepoint logs the old value, and at the safepoint
+// the counts are updated once per logged field no matter how many times it was written. Objects with zero count are
+// kept in the zero count table and are freed at the safepoint if no root references them.
+// Objects and handles are not thread-safe, every thread has its own heap. Cycles are not collected.
+
+class DeferredHeap;
+class DeferredFieldBase;
+
+class DeferredObjectHeader {
+public:
+    DeferredObjectHeader() = default;
+    NO_COPY_SEMANTIC(DeferredObjectHeader);
+    NO_MOVE_SEMANTIC(DeferredObjectHeader);
+
+    /// @returns count of references from heap fields which is valid at the last safepoint
+    size_t GetRefCount() const
+    {
+        return refCount_;
+    }
+
+protected:
+    virtual ~DeferredObjectHeader() = default;
+
+private:
+    friend class DeferredHeap;
+
+    size_t refCount_ {0};
+    bool inZct_ {false};
+    bool marked_ {false};  // is referenced by a root during the safepoint
+};
+
+template <class T>
+class DeferredBox final : public DeferredObjectHeader {
+public:
+    template <class... Args>
+    explicit DeferredBox(Args &&...args) : value_(std::forward<Args>(args)...)
+    {
+    }
+    NO_COPY_SEMANTIC(DeferredBox);
+    NO_MOVE_SEMANTIC(DeferredBox);
+    ~DeferredBox() override = default;
+
+    T *GetValue()
+    {
+        return &value_;
+    }
+
+private:
+    T value_;
+};
+
+/// Element of the intrusive list of roots, list is used instead of a stack because handles can be moved anywhere
+class DeferredRoot {
+public:
+    DeferredObjectHeader *GetHeader() const
+    {
+        return header_;
+    }
+
+protected:
+    inline explicit DeferredRoot(DeferredObjectHeader *header);
+    inline ~DeferredRoot();
+    NO_COPY_SEMANTIC(DeferredRoot);
+    NO_MOVE_SEMANTIC(DeferredRoot);
+
+    DeferredObjectHeader *header_;  // NOLINT(misc-non-private-member-variables-in-classes)
+
+private:
+    friend class DeferredHeap;
+
+    DeferredRoot *prev_ {nullptr};
+    DeferredRoot *next_ {nullptr};
+};
+
+class DeferredHeap {
+public:
+    static constexpr size_t DEFAULT_SAFEPOINT_THRESHOLD = 16384U;
+
+    static DeferredHeap &Get()
+    {
+        if (UNLIKELY(destroyed_)) {
+            // handles which outlive the heap on thread exit use its orphaned state
+            if (orphan_ == nullptr) {
+                orphan_ = new DeferredHeap();
+            }
+            return *orphan_;
+        }
+        thread_local DeferredHeap heap;
+        return heap;
+    }
+
+    /// @returns true if the heap of the current thread is already destroyed on thread exit
+    static bool IsDestroyed()
+    {
+        return destroyed_;
+    }
+
+    /**
+     * @brief Applies logged field writes to counts and frees objects with zero count which are not referenced by
+     * roots. Raw pointers to objects which are referenced only by raw pointers become invalid.
+     * @returns count of freed objects
+     */
+    size_t Safepoint()
+    {
+        if (inSafepoint_) {
+            return 0;
+        }
+        inSafepoint_ = true;
+        ApplyLog();
+        for (DeferredRoot *root = roots_; root != nullptr; root = root->next_) {
+            if (root->header_ != nullptr) {
+                root->header_->marked_ = true;
+            }
+        }
+        size_t freed = 0;
+        size_t kept = 0;
+        // freeing of an object can add new entries to the table
+        for (size_t i = 0; i < zct_.size(); i++) {
+            DeferredObjectHeader *header = zct_[i];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+            if (header->refCount_ > 0) {
+                header->inZct_ = false;
+            } else if (header->marked_) {
+                zct_[kept++] = header;  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+            } else {
+                delete header;
+                freed++;
+            }
+        }
+        zct_.resize(kept);
+        for (DeferredRoot *root = roots_; root != nullptr; root = root->next_) {
+            if (root->header_ != nullptr) {
+                root->header_->marked_ = false;
+            }
+        }
+        inSafepoint_ = false;
+        return freed;
+    }
+
+    /// @brief Allocation calls Safepoint if the log or the zero count table is larger than @param threshold
+    void SetSafepointThreshold(size_t threshold)
+    {
+        safepointThreshold_ = threshold;
+    }
+
+    size_t GetLogSize() const
+    {
+        return log_.size();
+    }
+
+    size_t GetZctSize() const
+    {
+        return zct_.size();
+    }
+
+    template <class T, class... Args>
+    DeferredBox<T> *Allocate(Args &&...args)
+    {
+        if (UNLIKELY(log_.size() >= safepointThreshold_ || zct_.size() >= safepointThreshold_)) {
+            Safepoint();
+        }
+        auto *box = new DeferredBox<T>(std::forward<Args>(args)...);
+        // new object is referenced only by the handle which is returned
+        AddToZct(box);
+        return box;
+    }
+
+    /// @brief Frees unreachable objects, objects referenced by roots which outlive the heap are moved to the orphan
+    ~DeferredHeap()
+    {
+        // destructors of freed values can write fields, the last safepoint without garbage leaves an empty log
+        while (Safepoint() != 0) {
+        }
+        if (destroyed_) {
+            return;
+        }
+        destroyed_ = true;
+        if (roots_ != nullptr) {
+            orphan_ = new DeferredHeap();
+            orphan_->log_.swap(log_);
+            orphan_->zct_.swap(zct_);
+            orphan_->roots_ = std::exchange(roots_, nullptr);
+            orphan_->safepointThreshold_ = safepointThreshold_;
+        }
+    }
+    NO_COPY_SEMANTIC(DeferredHeap);
+    NO_MOVE_SEMANTIC(DeferredHeap);
+
+private:
+    friend class DeferredRoot;
+    friend class DeferredFieldBase;
+
+    static constexpr uint32_t NOT_LOGGED = UINT32_MAX;
+
+    struct LogEntry {
+        DeferredFieldBase *field;  // is nullptr if the field was destroyed after the write
+        DeferredObjectHeader *old;
+    };
+
+    DeferredHeap() = default;
+
+    void LinkRoot(DeferredRoot *root)
+    {
+        root->next_ = roots_;
+        if (roots_ != nullptr) {
+            roots_->prev_ = root;
+        }
+        roots_ = root;
+    }
+
+    void UnlinkRoot(DeferredRoot *root)
+    {
+        if (root->prev_ != nullptr) {
+            root->prev_->next_ = root->next_;
+        } else {
+            roots_ = root->next_;
+        }
+        if (root->next_ != nullptr) {
+            root->next_->prev_ = root->prev_;
+        }
+    }
+
+    uint32_t Log(DeferredFieldBase *field, DeferredObjectHeader *old)
+    {
+        log_.push_back({field, old});
+        return static_cast<uint32_t>(log_.size() - 1U);
+    }
+
+    void Unlog(uint32_t index)
+    {
+        log_[index].field = nullptr;  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+    }
+
+    void AddToZct(DeferredObjectHeader *header)
+    {
+        if (!header->inZct_) {
+            header->inZct_ = true;
+            zct_.push_back(header);
+        }
+    }
+
+    void Decrement(DeferredObjectHeader *header)
+    {
+        if (header != nullptr && --header->refCount_ == 0) {
+            AddToZct(header);
+        }
+    }
+
+    inline void ApplyLog();
+
+    /// @brief Frees objects of the orphan and the orphan itself when the last root outliving the heap is destroyed
+    static void ReleaseOrphan()
+    {
+        if (orphan_ == nullptr || orphan_->inSafepoint_ || orphan_->roots_ != nullptr) {
+            return;
+        }
+        while (orphan_->Safepoint() != 0) {
+        }
+        // destructors of freed values can create roots which are still alive
+        if (orphan_->roots_ == nullptr) {
+            delete std::exchange(orphan_, nullptr);
+        }
+    }
+
+    std::vector<LogEntry> log_;
+    std::vector<DeferredObjectHeader *> zct_;
+    DeferredRoot *roots_ {nullptr};
+    size_t safepointThreshold_ {DEFAULT_SAFEPOINT_THRESHOLD};
+    bool inSafepoint_ {false};
+
+    // are trivially destructible, so they can be used by destructors which run after the heap
+    static inline thread_local bool destroyed_ {false};
+    static inline thread_local DeferredHeap *orphan_ {nullptr};
+};
+
+DeferredRoot::DeferredRoot(DeferredObjectHeader *header) : header_(header)
+{
+    DeferredHeap::Get().LinkRoot(this);
+}
+
+DeferredRoot::~DeferredRoot()
+{
+    DeferredHeap::Get().UnlinkRoot(this);
+    if (UNLIKELY(DeferredHeap::IsDestroyed())) {
+        DeferredHeap::ReleaseOrphan();
+    }
+}
+
+/// Reference from a heap object, its count is updated lazily at the safepoint
+class DeferredFieldBase {
+public:
+    DeferredObjectHeader *GetHeader() const
+    {
+        return header_;
+    }
+
+protected:
+    DeferredFieldBase() = default;
+    explicit DeferredFieldBase(DeferredObjectHeader *header)
+    {
+        Store(header);
+    }
+    ~DeferredFieldBase()
+    {
+        if (logIndex_ != DeferredHeap::NOT_LOGGED) {
+            // the current value has not been counted yet, only the logged old value is released
+            DeferredHeap::Get().Unlog(logIndex_);
+        } else {
+            DeferredHeap::Get().Decrement(header_);
+        }
+        if (UNLIKELY(DeferredHeap::IsDestroyed())) {
+            DeferredHeap::ReleaseOrphan();
+        }
+    }
+    NO_COPY_SEMANTIC(DeferredFieldBase);
+    NO_MOVE_SEMANTIC(DeferredFieldBase);
+
+    void Store(DeferredObjectHeader *header)
+    {
+        if (logIndex_ == DeferredHeap::NOT_LOGGED) {
+            logIndex_ = DeferredHeap::Get().Log(this, header_);
+        }
+        header_ = header;
+    }
+
+private:
+    friend class DeferredHeap;
+
+    DeferredObjectHeader *header_ {nullptr};
+    uint32_t logIndex_ {DeferredHeap::NOT_LOGGED};
+};
+
+void DeferredHeap::ApplyLog()
+{
+    // increments go first, so objects which are still referenced never reach zero count
+    for (LogEntry &entry : log_) {
+        if (entry.field != nullptr) {
+            if (entry.field->header_ != nullptr) {
+                entry.field->header_->refCount_++;
+            }
+            entry.field->logIndex_ = NOT_LOGGED;
+        }
+    }
+    for (LogEntry &entry : log_) {
+        Decrement(entry.old);
+    }
+    log_.clear();
+}
+
+template <class T>
+class DeferredField;
+
+/// Reference from the stack, it is not counted and keeps the object alive as a root
+template <class T>
+class DeferredObject final : public DeferredRoot {
+public:
+    DeferredObject() : DeferredRoot(nullptr) {}
+    explicit DeferredObject(std::nullptr_t) : DeferredRoot(nullptr) {}
+    explicit DeferredObject(DeferredBox<T> *box) : DeferredRoot(box) {}
+    explicit DeferredObject(const DeferredField<T> &field) : DeferredRoot(field.GetHeader()) {}
+    ~DeferredObject() = default;
+
+    DeferredObject(const DeferredObject<T> &other) : DeferredRoot(other.header_) {}
+    DeferredObject<T> &operator=(const DeferredObject<T> &other)
+    {
+        header_ = other.header_;
+        return *this;
+    }
+    DeferredObject(DeferredObject<T> &&other) noexcept : DeferredRoot(other.header_) {}
+    DeferredObject<T> &operator=(DeferredObject<T> &&other) noexcept
+    {
+        header_ = other.header_;
+        return *this;
+    }
+    DeferredObject<T> &operator=(const DeferredField<T> &field)
+    {
+        header_ = field.GetHeader();
+        return *this;
+    }
+
+    T &operator*() const noexcept
+    {
+        return *Get();
+    }
+
+    T *operator->() const noexcept
+    {
+        return Get();
+    }
+
+    T *Get() const
+    {
+        return header_ != nullptr ? static_cast<DeferredBox<T> *>(header_)->GetValue() : nullptr;
+    }
+};
+
+template <class T>
+class DeferredField final : public DeferredFieldBase {
+public:
+    DeferredField() = default;
+    explicit DeferredField(std::nullptr_t) {}
+    explicit DeferredField(const DeferredObject<T> &object) : DeferredFieldBase(object.GetHeader()) {}
+    ~DeferredField() = default;
+
+    DeferredField(const DeferredField<T> &other) : DeferredFieldBase(other.GetHeader()) {}
+    // NOLINTNEXTLINE(bugprone-unhandled-self-assignment)
+    DeferredField<T> &operator=(const DeferredField<T> &other)
+    {
+        Store(other.GetHeader());
+        return *this;
+    }
+    DeferredField(DeferredField<T> &&other) noexcept : DeferredFieldBase(other.GetHeader())
+    {
+        other.Store(nullptr);
+    }
+    DeferredField<T> &operator=(DeferredField<T> &&other) noexcept
+    {
+        if (this != &other) {
+            Store(other.GetHeader());
+            other.Store(nullptr);
+        }
+        return *this;
+    }
+    DeferredField<T> &operator=(const DeferredObject<T> &object)
+    {
+        Store(object.GetHeader());
+        return *this;
+    }
+    DeferredField<T> &operator=(std::nullptr_t)
+    {
+        Store(nullptr);
+        return *this;
+    }
+
+    T &operator*() const noexcept
+    {
+        return *Get();
+    }
+
+    T *operator->() const noexcept
+    {
+        return Get();
+    }
+
+    T *Get() const
+    {
+        DeferredObjectHeader *header = GetHeader();
+        return header != nullptr ? static_cast<DeferredBox<T> *>(header)->GetValue() : nullptr;
+    }
+};
+
+template <class T, class... Args>
+DeferredObject<T> MakeDeferredObject(Args &&...args)
+{
+    return DeferredObject<T>(DeferredHeap::Get().Allocate<T>(std::forward<Args>(args)...));
+}
+
+#endif  // MEMORY_MANAGEMENT_REFERECNCE_COUNTING_GC_INCLUDE_DEFERRED_OBJECT_H
@@ -1,16 +1,579 @@
 #ifndef MEMORY_MANAGEMENT_REFERECNCE_COUNTING_GC_INCLUDE_OBJECT_MODEL_H
 #define MEMORY_MANAGEMENT_REFERECNCE_COUNTING_GC_INCLUDE_OBJECT_MODEL_H
 
+#include <array>
 #include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "base/macros.h"
+#include "memory_management/run_of_slots_allocator/include/run_of_slots_allocator.h"
 
 template <class T>
 class Object;
+class ObjectControlBlock;
 
 template <class T, class... Args>
-static Object<T> MakeObject([[maybe_unused]] Args... args)
+Object<T> MakeObject(Args &&...args);
+template <class T>
+class WeakObject;
+
+/// Visitor which trace hooks call for every Object<...> field of the traced value
+class ObjectVisitor {
+public:
+    template <class T>
+    void operator()(const Object<T> &object);
+
+    virtual void Visit(ObjectControlBlock *block) = 0;
+
+protected:
+    ObjectVisitor() = default;
+    ~ObjectVisitor() = default;
+    DEFAULT_COPY_SEMANTIC(ObjectVisitor);
+    DEFAULT_MOVE_SEMANTIC(ObjectVisitor);
+};
+
+/**
+ * Trace hook of type T. A type which can take part in a cycle reports its Object<...> fields either by the method
+ *     void TraceObjects(ObjectVisitor &visitor) const { visitor(field1_); visitor(field2_); }
+ * or by a specialization of ObjectTracer. Types without the hook are treated as acyclic and are never suspected
+ * as cycle roots, so all Object<...> fields of a type with the hook must be reported.
+ */
+template <class T, class = void>
+struct ObjectTracer {
+    static constexpr bool ACYCLIC = true;
+
+    static void Trace([[maybe_unused]] const T &value, [[maybe_unused]] ObjectVisitor &visitor) {}
+};
+
+template <class T>
+struct ObjectTracer<T, std::void_t<decltype(std::declval<const T &>().TraceObjects(std::declval<ObjectVisitor &>()))>> {
+    static constexpr bool ACYCLIC = false;
+
+    static void Trace(const T &value, ObjectVisitor &visitor)
+    {
+        value.TraceObjects(visitor);
+    }
+};
+
+/// Colors of the synchronous cycle collection (Bacon, Rajan "Concurrent Cycle Collection in Reference Counted Systems")
+enum class ObjectColor : uint8_t {
+    BLACK,    // in use or already freed
+    GRAY,     // possible member of a garbage cycle
+    WHITE,    // member of a garbage cycle
+    PURPLE,   // possible root of a garbage cycle
+    GARBAGE,  // is being freed by the collector
+};
+
+/**
+ * Reference count and cycle collection state of one object, the object value is owned by the derived class.
+ * The value is destroyed when the strong count drops to zero, the block itself waits for the weak count.
+ */
+class ObjectControlBlock {
+public:
+    explicit ObjectControlBlock(bool acyclic) : acyclic_(acyclic) {}
+    NO_COPY_SEMANTIC(ObjectControlBlock);
+    NO_MOVE_SEMANTIC(ObjectControlBlock);
+
+    void IncRef()
+    {
+        refCount_++;
+        // references to garbage can be copied by destructors of the cycle, decrements of them should stay ignored
+        if (color_ != ObjectColor::GARBAGE) {
+            color_ = ObjectColor::BLACK;
+        }
+    }
+
+    /// @brief Frees the value when the last reference is gone, otherwise the object becomes a possible cycle root
+    inline void DecRef();
+
+    size_t GetRefCount() const
+    {
+        return refCount_;
+    }
+
+    void IncWeakRef()
+    {
+        weakCount_++;
+    }
+
+    /// @brief Frees the block of the destroyed value when the last weak reference is gone
+    void DecWeakRef()
+    {
+        if (--weakCount_ == 0 && orphaned_) {
+            Deallocate();
+        }
+    }
+
+    size_t GetWeakCount() const
+    {
+        return weakCount_;
+    }
+
+    /// @returns false if the value is destroyed or is being destroyed as a member of a garbage cycle
+    bool IsAlive() const
+    {
+        return refCount_ > 0 && color_ != ObjectColor::GARBAGE;
+    }
+
+protected:
+    virtual ~ObjectControlBlock() = default;
+
+    /// @brief Destroys the value, references which it holds are released
+    virtual void DestroyValue() = 0;
+    virtual void TraceValue(ObjectVisitor &visitor) = 0;
+    /// @brief Frees memory of the control block, is called after DestroyValue
+    virtual void Deallocate()
+    {
+        delete this;
+    }
+
+private:
+    friend class CycleCollector;
+
+    size_t refCount_ {1};
+    size_t weakCount_ {0};
+    ObjectColor color_ {ObjectColor::BLACK};
+    bool buffered_ {false};  // is in the roots buffer of the collector
+    bool orphaned_ {false};  // the value is destroyed, the block is freed by the last weak reference
+    bool acyclic_;
+};
+
+/**
+ * Synchronous trial deletion collector of garbage cycles. Every decrement to non zero count makes the object a
+ * possible root, roots are buffered and collected all together when their count reaches the threshold or when
+ * CollectCycles is called. Objects are not thread-safe, so every thread has its own collector.
+ * Destructors of static and thread local variables can run after the collector of the thread is destroyed, such
+ * objects are released directly and cycles which they hold are not collected.
+ */
+class CycleCollector {
+public:
+    static constexpr size_t DEFAULT_ROOTS_THRESHOLD = 8192U;
+
+    static CycleCollector &Get()
+    {
+        thread_local CycleCollector collector;
+        return collector;
+    }
+
+    /// @returns true if the collector of the current thread is already destroyed on thread exit
+    static bool IsDestroyed()
+    {
+        return destroyed_;
+    }
+
+    /// @returns count of freed objects
+    size_t CollectCycles()
+    {
+        if (collecting_) {
+            return 0;
+        }
+        collecting_ = true;
+        MarkRoots();
+        ScanRoots();
+        size_t collected = CollectRoots();
+        collecting_ = false;
+        return collected;
+    }
+
+    size_t GetRootsCount() const
+    {
+        return roots_.size();
+    }
+
+    /// @brief Sets count of buffered roots which triggers collection, 0 disables automatic collection
+    void SetRootsThreshold(size_t threshold)
+    {
+        rootsThreshold_ = threshold;
+    }
+
+    ~CycleCollector()
+    {
+        // destroyed garbage can buffer new roots, the last collection without garbage leaves no roots
+        while (CollectCycles() != 0) {
+        }
+        destroyed_ = true;
+    }
+    NO_COPY_SEMANTIC(CycleCollector);
+    NO_MOVE_SEMANTIC(CycleCollector);
+
+private:
+    friend class ObjectControlBlock;
+
+    template <class Callback>
+    class CallbackVisitor final : public ObjectVisitor {
+    public:
+        explicit CallbackVisitor(Callback callback) : callback_(callback) {}
+
+        void Visit(ObjectControlBlock *block) override
+        {
+            callback_(block);
+        }
+
+    private:
+        Callback callback_;
+    };
+
+    inline CycleCollector();
+
+    template <class Callback>
+    static void ForEachChild(ObjectControlBlock *block, Callback callback)
+    {
+        CallbackVisitor<Callback> visitor(callback);
+        block->TraceValue(visitor);
+    }
+
+    void Release(ObjectControlBlock *block)
+    {
+        block->color_ = ObjectColor::BLACK;
+        // collection during the release could free the block which is buffered
+        releaseDepth_++;
+        block->DestroyValue();
+        releaseDepth_--;
+        if (!block->buffered_) {
+            FreeBlock(block);
+        }
+    }
+
+    /// @brief Frees the block of the destroyed value, the block with weak references is left to them
+    static void FreeBlock(ObjectControlBlock *block)
+    {
+        if (block->weakCount_ > 0) {
+            block->orphaned_ = true;
+        } else {
+            block->Deallocate();
+        }
+    }
+
+    void PossibleRoot(ObjectControlBlock *block)
+    {
+        if (block->color_ != ObjectColor::PURPLE) {
+            block->color_ = ObjectColor::PURPLE;
+            if (!block->buffered_) {
+                block->buffered_ = true;
+                roots_.push_back(block);
+            }
+        }
+        if (UNLIKELY(roots_.size() >= rootsThreshold_) && rootsThreshold_ != 0 && releaseDepth_ == 0) {
+            CollectCycles();
+        }
+    }
+
+    void MarkRoots()
+    {
+        size_t kept = 0;
+        for (ObjectControlBlock *block : roots_) {
+            if (block->color_ == ObjectColor::PURPLE && block->refCount_ > 0) {
+                MarkGray(block);
+                roots_[kept++] = block;
+                continue;
+            }
+            block->buffered_ = false;
+            if (block->color_ == ObjectColor::BLACK && block->refCount_ == 0) {
+                FreeBlock(block);
+            }
+        }
+        roots_.resize(kept);
+    }
+
+    /// @brief Removes references inside the subgraph of @param root from counts
+    void MarkGray(ObjectControlBlock *root)
+    {
+        if (root->color_ == ObjectColor::GRAY) {
+            return;
+        }
+        root->color_ = ObjectColor::GRAY;
+        stack_.push_back(root);
+        while (!stack_.empty()) {
+            ObjectControlBlock *block = stack_.back();
+            stack_.pop_back();
+            ForEachChild(block, [this](ObjectControlBlock *child) {
+                child->refCount_--;
+                if (child->color_ != ObjectColor::GRAY) {
+                    child->color_ = ObjectColor::GRAY;
+                    stack_.push_back(child);
+                }
+            });
+        }
+    }
+
+    void ScanRoots()
+    {
+        for (ObjectControlBlock *root : roots_) {
+            stack_.push_back(root);
+            while (!stack_.empty()) {
+                ObjectControlBlock *block = stack_.back();
+                stack_.pop_back();
+                if (block->color_ != ObjectColor::GRAY) {
+                    continue;
+                }
+                if (block->refCount_ > 0) {
+                    ScanBlack(block);
+                    continue;
+                }
+                block->color_ = ObjectColor::WHITE;
+                ForEachChild(block, [this](ObjectControlBlock *child) { stack_.push_back(child); });
+            }
+        }
+    }
+
+    /// @brief Restores counts inside the subgraph of @param root which is referenced from outside
+    void ScanBlack(ObjectControlBlock *root)
+    {
+        root->color_ = ObjectColor::BLACK;
+        blackStack_.push_back(root);
+        while (!blackStack_.empty()) {
+            ObjectControlBlock *block = blackStack_.back();
+            blackStack_.pop_back();
+            ForEachChild(block, [this](ObjectControlBlock *child) {
+                child->refCount_++;
+                if (child->color_ != ObjectColor::BLACK) {
+                    child->color_ = ObjectColor::BLACK;
+                    blackStack_.push_back(child);
+                }
+            });
+        }
+    }
+
+    size_t CollectRoots()
+    {
+        std::vector<ObjectControlBlock *> garbage;
+        for (ObjectControlBlock *root : roots_) {
+            root->buffered_ = false;
+            CollectWhite(root, &garbage);
+        }
+        roots_.clear();
+        // references between garbage objects are restored, so the values are destroyed as usual, and decrements of
+        // garbage objects are ignored while they have the GARBAGE color
+        for (ObjectControlBlock *block : garbage) {
+            ForEachChild(block, [](ObjectControlBlock *child) { child->refCount_++; });
+        }
+        for (ObjectControlBlock *block : garbage) {
+            block->DestroyValue();
+        }
+        for (ObjectControlBlock *block : garbage) {
+            FreeBlock(block);
+        }
+        return garbage.size();
+    }
+
+    void CollectWhite(ObjectControlBlock *root, std::vector<ObjectControlBlock *> *garbage)
+    {
+        if (root->color_ != ObjectColor::WHITE || root->buffered_) {
+            return;
+        }
+        root->color_ = ObjectColor::GARBAGE;
+        stack_.push_back(root);
+        while (!stack_.empty()) {
+            ObjectControlBlock *block = stack_.back();
+            stack_.pop_back();
+            garbage->push_back(block);
+            ForEachChild(block, [this](ObjectControlBlock *child) {
+                if (child->color_ == ObjectColor::WHITE && !child->buffered_) {
+                    child->color_ = ObjectColor::GARBAGE;
+                    stack_.push_back(child);
+                }
+            });
+        }
+    }
+
+    std::vector<ObjectControlBlock *> roots_;
+    std::vector<ObjectControlBlock *> stack_;
+    std::vector<ObjectControlBlock *> blackStack_;  // ScanBlack is called while ScanRoots uses stack_
+    size_t rootsThreshold_ {DEFAULT_ROOTS_THRESHOLD};
+    size_t releaseDepth_ {0};
+    bool collecting_ {false};
+
+    // flag is trivially destructible, so it can be read by destructors which run after the collector
+    static inline thread_local bool destroyed_ {false};
+};
+
+/// Slots for objects created by MakeObject, control block and value share one slot
+class ObjectAllocator {
+public:
+    static constexpr size_t RUN_SIZE = 64U * 1024U;
+    static constexpr size_t MAX_SLOT_SIZE = 512U;
+    using SlotsAllocator = RunOfSlotsAllocator<RUN_SIZE, 32U, 48U, 64U, 96U, 128U, 192U, 256U, 384U, MAX_SLOT_SIZE>;
+
+    static void *Allocate(size_t size)
+    {
+        void *slot = LIKELY(!cacheDestroyed_) ? GetCache().Allocate(size) : GetSlotsAllocator().Allocate(size);
+        if (UNLIKELY(slot == nullptr)) {
+            throw std::bad_alloc();
+        }
+        return slot;
+    }
+
+    static void Free(void *slot)
+    {
+        if (LIKELY(!cacheDestroyed_)) {
+            GetCache().Free(slot);
+        } else {
+            GetSlotsAllocator().Free(slot);
+        }
+    }
+
+    static SlotsAllocator &GetSlotsAllocator()
+    {
+        // is never destroyed, so objects can be freed by destructors of static and thread local variables
+        static auto *allocator = new SlotsAllocator(SlotsAllocator::RetentionPolicy {SIZE_MAX, 1U});
+        return *allocator;
+    }
+
+    /// @brief Cache of the current thread, it is destroyed on thread exit before some thread local destructors
+    static SlotsAllocator::ThreadCache &GetCache()
+    {
+        thread_local CacheHolder holder;
+        return holder.cache;
+    }
+
+private:
+    struct CacheHolder {
+        CacheHolder() = default;
+        ~CacheHolder()
+        {
+            // later destructors use the shared runs
+            cacheDestroyed_ = true;
+        }
+        NO_COPY_SEMANTIC(CacheHolder);
+        NO_MOVE_SEMANTIC(CacheHolder);
+
+        SlotsAllocator::ThreadCache cache {GetSlotsAllocator()};  // NOLINT(misc-non-private-member-variables-in-classes)
+    };
+
+    // flag is trivially destructible, so it can be read after the cache is destroyed
+    static inline thread_local bool cacheDestroyed_ {false};
+};
+
+CycleCollector::CycleCollector()
+{
+    // the cache is created first, so it is destroyed after the collector which frees objects on thread exit
+    ObjectAllocator::GetCache();
+}
+
+void ObjectControlBlock::DecRef()
 {
-    // TODO(you): Implemet this finction
-    return {};
+    if (UNLIKELY(color_ == ObjectColor::GARBAGE)) {
+        refCount_--;
+        return;
+    }
+    if (UNLIKELY(CycleCollector::IsDestroyed())) {
+        if (--refCount_ == 0) {
+            DestroyValue();
+            CycleCollector::FreeBlock(this);
+        }
+        return;
+    }
+    if (--refCount_ == 0) {
+        CycleCollector::Get().Release(this);
+    } else if (!acyclic_) {
+        CycleCollector::Get().PossibleRoot(this);
+    }
+}
+
+/// Control block of a value allocated separately by new
+template <class T>
+class PointerControlBlock final : public ObjectControlBlock {
+public:
+    explicit PointerControlBlock(T *ptr) : ObjectControlBlock(ObjectTracer<T>::ACYCLIC), ptr_(ptr) {}
+    NO_COPY_SEMANTIC(PointerControlBlock);
+    NO_MOVE_SEMANTIC(PointerControlBlock);
+
+protected:
+    ~PointerControlBlock() override = default;
+
+    void DestroyValue() override
+    {
+        delete std::exchange(ptr_, nullptr);
+    }
+
+    void TraceValue(ObjectVisitor &visitor) override
+    {
+        if (ptr_ != nullptr) {
+            ObjectTracer<T>::Trace(*ptr_, visitor);
+        }
+    }
+
+private:
+    T *ptr_;
+};
+
+/// Control block with the value inside, it is allocated from ObjectAllocator
+template <class T>
+class InplaceControlBlock final : public ObjectControlBlock {
+public:
+    template <class... Args>
+    explicit InplaceControlBlock(Args &&...args) : ObjectControlBlock(ObjectTracer<T>::ACYCLIC)
+    {
+        new (storage_.data()) T(std::forward<Args>(args)...);
+    }
+    NO_COPY_SEMANTIC(InplaceControlBlock);
+    NO_MOVE_SEMANTIC(InplaceControlBlock);
+
+    static constexpr bool IsInSlot()
+    {
+        return sizeof(InplaceControlBlock<T>) <= ObjectAllocator::MAX_SLOT_SIZE &&
+               alignof(T) <= alignof(std::max_align_t);
+    }
+
+    template <class... Args>
+    static InplaceControlBlock<T> *Create(Args &&...args)
+    {
+        static_assert(IsInSlot());
+        void *slot = ObjectAllocator::Allocate(sizeof(InplaceControlBlock<T>));
+        try {
+            return new (slot) InplaceControlBlock<T>(std::forward<Args>(args)...);
+        } catch (...) {
+            ObjectAllocator::Free(slot);
+            throw;
+        }
+    }
+
+    T *GetValue()
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        return std::launder(reinterpret_cast<T *>(storage_.data()));
+    }
+
+protected:
+    ~InplaceControlBlock() override = default;
+
+    void DestroyValue() override
+    {
+        GetValue()->~T();
+    }
+
+    void TraceValue(ObjectVisitor &visitor) override
+    {
+        ObjectTracer<T>::Trace(*GetValue(), visitor);
+    }
+
+    void Deallocate() override
+    {
+        this->~InplaceControlBlock();
+        ObjectAllocator::Free(this);
+    }
+
+private:
+    alignas(T) std::array<std::byte, sizeof(T)> storage_;
+};
+
+/**
+ * @brief Creates value of T from @param args together with its control block in one slot. Value which does not fit
+ * into a slot is allocated separately, so its memory is not held by weak references after it is destroyed.
+ */
+template <class T, class... Args>
+Object<T> MakeObject(Args &&...args)
+{
+    if constexpr (InplaceControlBlock<T>::IsInSlot()) {
+        auto *block = InplaceControlBlock<T>::Create(std::forward<Args>(args)...);
+        return Object<T>(block->GetValue(), block);
+    } else {
+        return Object<T>(new T(std::forward<Args>(args)...));
+    }
 }
 
 template <class T>
@@ -18,48 +581,185 @@ class Object {
 public:
     Object() = default;
     explicit Object(std::nullptr_t) {}
-    explicit Object([[maybe_unused]] T *ptr) {}
+    explicit Object(T *ptr) : val_(ptr)
+    {
+        if (ptr != nullptr) {
+            std::unique_ptr<T> holder(ptr);
+            block_ = new PointerControlBlock<T>(ptr);
+            holder.release();
+        }
+    }
 
-    ~Object() = default; // this method should be changed
+    ~Object()
+    {
+        val_ = nullptr;
+        if (block_ != nullptr) {
+            std::exchange(block_, nullptr)->DecRef();
+        }
+    }
 
     // copy semantic
-    Object([[maybe_unused]] const Object<T> &other) {}
+    Object(const Object<T> &other) : val_(other.val_), block_(other.block_)
+    {
+        if (block_ != nullptr) {
+            block_->IncRef();
+        }
+    }
     // NOLINTNEXTLINE(bugprone-unhandled-self-assignment)
-    Object<T> &operator=([[maybe_unused]] const Object<T> &other)
+    Object<T> &operator=(const Object<T> &other)
     {
+        // the old value is released after the new one is set, so the graph is consistent for the collector
+        Object<T>(other).Swap(*this);
         return *this;
     }
 
     // move semantic
-    Object([[maybe_unused]] Object<T> &&other) {}
-    Object<T> &operator=([[maybe_unused]] Object<T> &&other)
+    Object(Object<T> &&other) noexcept
+        : val_(std::exchange(other.val_, nullptr)), block_(std::exchange(other.block_, nullptr))
     {
+    }
+    Object<T> &operator=(Object<T> &&other) noexcept
+    {
+        Object<T>(std::move(other)).Swap(*this);
         return *this;
     }
 
     // member access operators
-    T &operator*() const noexcept {
+    T &operator*() const noexcept
+    {
         return *val_;
     }
 
-    T *operator->() const noexcept {
+    T *operator->() const noexcept
+    {
         return val_;
     }
 
     // internal access
-    void Reset([[maybe_unused]] T *ptr) {}
+    void Reset(T *ptr)
+    {
+        Object<T>(ptr).Swap(*this);
+    }
     T *Get() const
     {
         return val_;
     }
     size_t UseCount() const
     {
-        return 0;
+        return block_ != nullptr ? block_->GetRefCount() : 0;
+    }
+
+    void Swap(Object<T> &other) noexcept
+    {
+        std::swap(val_, other.val_);
+        std::swap(block_, other.block_);
+    }
+
+private:
+    friend class ObjectVisitor;
+    friend class WeakObject<T>;
+    template <class U, class... Args>
+    friend Object<U> MakeObject(Args &&...args);
+
+    Object(T *val, ObjectControlBlock *block) : val_(val), block_(block) {}
+
+    T *val_ {nullptr};
+    ObjectControlBlock *block_ {nullptr};
+};
+
+/// Reference which does not keep the value alive, it is not traced by the cycle collector
+template <class T>
+class WeakObject {
+public:
+    WeakObject() = default;
+    explicit WeakObject(std::nullptr_t) {}
+    explicit WeakObject(const Object<T> &object) : val_(object.val_), block_(object.block_)
+    {
+        if (block_ != nullptr) {
+            block_->IncWeakRef();
+        }
+    }
+
+    ~WeakObject()
+    {
+        val_ = nullptr;
+        if (block_ != nullptr) {
+            std::exchange(block_, nullptr)->DecWeakRef();
+        }
+    }
+
+    // copy semantic
+    WeakObject(const WeakObject<T> &other) : val_(other.val_), block_(other.block_)
+    {
+        if (block_ != nullptr) {
+            block_->IncWeakRef();
+        }
+    }
+    // NOLINTNEXTLINE(bugprone-unhandled-self-assignment)
+    WeakObject<T> &operator=(const WeakObject<T> &other)
+    {
+        WeakObject<T>(other).Swap(*this);
+        return *this;
+    }
+    WeakObject<T> &operator=(const Object<T> &object)
+    {
+        WeakObject<T>(object).Swap(*this);
+        return *this;
+    }
+
+    // move semantic
+    WeakObject(WeakObject<T> &&other) noexcept
+        : val_(std::exchange(other.val_, nullptr)), block_(std::exchange(other.block_, nullptr))
+    {
+    }
+    WeakObject<T> &operator=(WeakObject<T> &&other) noexcept
+    {
+        WeakObject<T>(std::move(other)).Swap(*this);
+        return *this;
+    }
+
+    /// @returns strong reference to the value or nullptr if it is destroyed
+    Object<T> Lock() const
+    {
+        if (block_ == nullptr || !block_->IsAlive()) {
+            return Object<T>();
+        }
+        block_->IncRef();
+        return Object<T>(val_, block_);
+    }
+
+    bool Expired() const
+    {
+        return block_ == nullptr || !block_->IsAlive();
+    }
+
+    size_t UseCount() const
+    {
+        return block_ != nullptr && block_->IsAlive() ? block_->GetRefCount() : 0;
+    }
+
+    void Reset()
+    {
+        WeakObject<T>().Swap(*this);
+    }
+
+    void Swap(WeakObject<T> &other) noexcept
+    {
+        std::swap(val_, other.val_);
+        std::swap(block_, other.block_);
     }
 
 private:
-    // TODO(you): Add your fields and methods here...
-    T* val_ = nullptr; // this field can be deleted
+    T *val_ {nullptr};
+    ObjectControlBlock *block_ {nullptr};
 };
 
-#endif  // MEMORY_MANAGEMENT_REFERECNCE_COUNTING_GC_INCLUDE_OBJECT_MODEL_H
\ No newline at end of file
+template <class T>
+void ObjectVisitor::operator()(const Object<T> &object)
+{
+    if (object.block_ != nullptr) {
+        Visit(object.block_);
+    }
+}
+
+#endif  // MEMORY_MANAGEMENT_REFERECNCE_COUNTING_GC_INCLUDE_OBJECT_MODEL_H
@@ -0,0 +1,410 @@
+#ifndef MEMORY_MANAGEMENT_REFERECNCE_COUNTING_GC_INCLUDE_SHARED_OBJECT_H
+#define MEMORY_MANAGEMENT_REFERECNCE_COUNTING_GC_INCLUDE_SHARED_OBJECT_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "base/macros.h"
+
+// Thread-safe reference counting with biased counts (Choi, Shull, Torrellas "Biased Reference Counting").
+// Every object is biased to the thread which has created it: the owner thread updates the biased count without
+// atomic read-modify-write, other threads update the atomic shared count. The shared count can become negative when
+// other threads release references which were created by the owner, then the object is queued to the owner which
+// merges the counts. The owner merges them as well when its biased count drops to zero, after that the object is
+// counted by the shared count only. Thread which has returned its record on exit owns nothing: its updates go to the
+// shared count and its new objects are created merged.
+
+class SharedObjectHeader;
+
+/**
+ * Per-thread owner record. Records of finished threads are reused by new threads together with their objects.
+ * Record without owner thread has nobody to process its queue, so threads which queue objects to it merge them.
+ */
+class BiasedOwner {
+public:
+    /// @returns record of the current thread or nullptr if the thread has already returned it on exit
+    static BiasedOwner *Current()
+    {
+        if (UNLIKELY(current_ == nullptr)) {
+            if (finished_) {
+                return nullptr;
+            }
+            thread_local CurrentHolder holder;
+            current_ = holder.Get();
+            // objects could be queued to the reused record while its previous owner was finishing
+            current_->ProcessQueue();
+        }
+        return current_;
+    }
+
+    /// @brief Merges counts of objects queued by other threads, is called by the owner thread
+    inline size_t ProcessQueue();
+
+    bool HasQueued() const
+    {
+        return queue_.load(std::memory_order_relaxed) != nullptr;
+    }
+
+    BiasedOwner() = default;
+    ~BiasedOwner() = default;
+    NO_COPY_SEMANTIC(BiasedOwner);
+    NO_MOVE_SEMANTIC(BiasedOwner);
+
+private:
+    friend class SharedObjectHeader;
+
+    /// Takes a free record on the first use in the thread and returns it on the thread exit
+    class CurrentHolder {
+    public:
+        CurrentHolder()
+        {
+            Registry &registry = GetRegistry();
+            std::lock_guard lock(registry.lock);
+            if (registry.free.empty()) {
+                registry.all.push_back(std::make_unique<BiasedOwner>());
+                owner_ = registry.all.back().get();
+            } else {
+                owner_ = registry.free.back();
+                registry.free.pop_back();
+                owner_->ownerless_.store(false, std::memory_order_seq_cst);
+            }
+        }
+        ~CurrentHolder()
+        {
+            owner_->ProcessQueue();
+            current_ = nullptr;
+            // handles released by later destructors of the thread must not take the record again
+            finished_ = true;
+            {
+                Registry &registry = GetRegistry();
+                std::lock_guard lock(registry.lock);
+                owner_->ownerless_.store(true, std::memory_order_seq_cst);
+                registry.free.push_back(owner_);
+            }
+            // objects queued after the first pass are merged here, the later ones by the threads which queue them
+            owner_->MergeOwnerless();
+        }
+        NO_COPY_SEMANTIC(CurrentHolder);
+        NO_MOVE_SEMANTIC(CurrentHolder);
+
+        BiasedOwner *Get() const
+        {
+            return owner_;
+        }
+
+    private:
+        BiasedOwner *owner_;
+    };
+
+    struct Registry {
+        std::mutex lock;
+        std::vector<std::unique_ptr<BiasedOwner>> all;
+        std::vector<BiasedOwner *> free;
+    };
+
+    static Registry &GetRegistry()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    inline void Enqueue(SharedObjectHeader *header);
+    /// @brief Merges queued objects if the record has no owner, the registry lock keeps it from being reused
+    inline void MergeOwnerless();
+
+    static thread_local BiasedOwner *current_;
+    // is trivially destructible, so it can be read by destructors which run after the holder of the record
+    static inline thread_local bool finished_ {false};
+
+    std::atomic<SharedObjectHeader *> queue_ {nullptr};
+    std::atomic<bool> ownerless_ {false};
+};
+
+inline thread_local BiasedOwner *BiasedOwner::current_ = nullptr;
+
+class SharedObjectHeader {
+public:
+    SharedObjectHeader() : owner_(BiasedOwner::Current())
+    {
+        if (UNLIKELY(owner_.load(std::memory_order_relaxed) == nullptr)) {
+            // the thread has no record anymore, so the object is counted by the shared count from the start
+            biased_.store(0, std::memory_order_relaxed);
+            shared_.store(COUNT_UNIT | MERGED, std::memory_order_relaxed);
+        }
+    }
+    NO_COPY_SEMANTIC(SharedObjectHeader);
+    NO_MOVE_SEMANTIC(SharedObjectHeader);
+
+    void IncRef()
+    {
+        if (LIKELY(IsOwnedByCurrent())) {
+            // only the owner writes the biased count, so the atomic is used for plain load and store
+            biased_.store(biased_.load(std::memory_order_relaxed) + 1U, std::memory_order_relaxed);
+        } else {
+            shared_.fetch_add(COUNT_UNIT, std::memory_order_relaxed);
+        }
+    }
+
+    void DecRef()
+    {
+        if (LIKELY(IsOwnedByCurrent())) {
+            uint32_t biased = biased_.load(std::memory_order_relaxed) - 1U;
+            biased_.store(biased, std::memory_order_relaxed);
+            if (UNLIKELY(biased == 0)) {
+                ImplicitMerge();
+            }
+        } else {
+            SlowDecRef();
+        }
+    }
+
+    /// @returns estimation of the count, it is exact if other threads do not change it
+    size_t GetRefCount() const
+    {
+        int64_t count = static_cast<int64_t>(biased_.load(std::memory_order_relaxed)) +
+                        GetCount(shared_.load(std::memory_order_relaxed));
+        return count > 0 ? static_cast<size_t>(count) : 0U;
+    }
+
+    bool IsBiased() const
+    {
+        return owner_.load(std::memory_order_relaxed) != nullptr;
+    }
+
+protected:
+    virtual ~SharedObjectHeader() = default;
+
+private:
+    friend class BiasedOwner;
+
+    // shared count is stored above the flags
+    static constexpr int64_t MERGED = 1;
+    static constexpr int64_t QUEUED = 2;
+    static constexpr int64_t COUNT_UNIT = 4;
+
+    static int64_t GetCount(int64_t shared)
+    {
+        return shared >> 2U;  // NOLINT(hicpp-signed-bitwise)
+    }
+
+    bool IsOwnedByCurrent() const
+    {
+        BiasedOwner *current = BiasedOwner::Current();
+        // merged objects have no owner, they must not match a finished thread
+        return current != nullptr && owner_.load(std::memory_order_relaxed) == current;
+    }
+
+    /// @brief Is called by the owner when it has no references anymore
+    void ImplicitMerge()
+    {
+        int64_t old = shared_.fetch_or(MERGED, std::memory_order_acq_rel);
+        // is stored after the merge, so a thread which sees no owner sees the merged count
+        owner_.store(nullptr, std::memory_order_release);
+        // queued object is freed by the owner when it processes the queue
+        if (GetCount(old) == 0 && (old & QUEUED) == 0) {
+            delete this;
+        }
+    }
+
+    /**
+     * @brief Is called for the object from the queue by the owner or by any thread if the record has no owner
+     * @returns true if the object has no references and should be deleted
+     */
+    bool ExplicitMerge()
+    {
+        int64_t biased = biased_.load(std::memory_order_relaxed);
+        biased_.store(0, std::memory_order_relaxed);
+        owner_.store(nullptr, std::memory_order_relaxed);
+        int64_t old = shared_.load(std::memory_order_relaxed);
+        int64_t desired = 0;
+        do {
+            desired = (old + biased * COUNT_UNIT) | MERGED;
+            desired &= ~QUEUED;
+        } while (!shared_.compare_exchange_weak(old, desired, std::memory_order_acq_rel));
+        return GetCount(desired) == 0;
+    }
+
+    void SlowDecRef()
+    {
+        // the owner is read before the decrement: it is still valid if the decrement happens before the merge
+        BiasedOwner *owner = owner_.load(std::memory_order_acquire);
+        int64_t old = shared_.load(std::memory_order_relaxed);
+        int64_t desired = 0;
+        do {
+            desired = old - COUNT_UNIT;
+            if ((desired & MERGED) == 0 && GetCount(desired) < 0) {
+                desired |= QUEUED;
+            }
+        } while (!shared_.compare_exchange_weak(old, desired, std::memory_order_acq_rel));
+        if ((desired & QUEUED) != 0 && (old & QUEUED) == 0) {
+            owner->Enqueue(this);
+        } else if ((desired & (MERGED | QUEUED)) == MERGED && GetCount(desired) == 0) {
+            delete this;
+        }
+    }
+
+    std::atomic<BiasedOwner *> owner_;
+    std::atomic<uint32_t> biased_ {1U};
+    std::atomic<int64_t> shared_ {0};
+    SharedObjectHeader *queueNext_ {nullptr};
+};
+
+void BiasedOwner::Enqueue(SharedObjectHeader *header)
+{
+    SharedObjectHeader *head = queue_.load(std::memory_order_relaxed);
+    do {
+        header->queueNext_ = head;
+    } while (!queue_.compare_exchange_weak(head, header, std::memory_order_seq_cst, std::memory_order_relaxed));
+    // either the finishing owner sees the object in the queue or this thread sees the flag
+    if (UNLIKELY(ownerless_.load(std::memory_order_seq_cst))) {
+        MergeOwnerless();
+    }
+}
+
+size_t BiasedOwner::ProcessQueue()
+{
+    size_t processed = 0;
+    SharedObjectHeader *header = queue_.exchange(nullptr, std::memory_order_seq_cst);
+    while (header != nullptr) {
+        SharedObjectHeader *next = header->queueNext_;
+        if (header->ExplicitMerge()) {
+            delete header;
+        }
+        header = next;
+        processed++;
+    }
+    return processed;
+}
+
+void BiasedOwner::MergeOwnerless()
+{
+    SharedObjectHeader *dead = nullptr;
+    {
+        Registry &registry = GetRegistry();
+        std::lock_guard lock(registry.lock);
+        if (!ownerless_.load(std::memory_order_relaxed)) {
+            // the record is reused, its new owner processes the queue
+            return;
+        }
+        SharedObjectHeader *header = queue_.exchange(nullptr, std::memory_order_seq_cst);
+        while (header != nullptr) {
+            SharedObjectHeader *next = header->queueNext_;
+            if (header->ExplicitMerge()) {
+                header->queueNext_ = dead;
+                dead = header;
+            }
+            header = next;
+        }
+    }
+    // destructors of the values can queue objects again, so they are called without the lock
+    while (dead != nullptr) {
+        SharedObjectHeader *next = dead->queueNext_;
+        delete dead;
+        dead = next;
+    }
+}
+
+template <class T>
+class SharedBox final : public SharedObjectHeader {
+public:
+    template <class... Args>
+    explicit SharedBox(Args &&...args) : value_(std::forward<Args>(args)...)
+    {
+    }
+    NO_COPY_SEMANTIC(SharedBox);
+    NO_MOVE_SEMANTIC(SharedBox);
+    ~SharedBox() override = default;
+
+    T *GetValue()
+    {
+        return &value_;
+    }
+
+private:
+    T value_;
+};
+
+/// Thread-safe counterpart of Object<T>, one handle must not be changed by several threads at the same time
+template <class T>
+class SharedObject {
+public:
+    SharedObject() = default;
+    explicit SharedObject(std::nullptr_t) {}
+    explicit SharedObject(SharedBox<T> *box) : box_(box) {}
+
+    ~SharedObject()
+    {
+        if (box_ != nullptr) {
+            std::exchange(box_, nullptr)->DecRef();
+        }
+    }
+
+    SharedObject(const SharedObject<T> &other) : box_(other.box_)
+    {
+        if (box_ != nullptr) {
+            box_->IncRef();
+        }
+    }
+    // NOLINTNEXTLINE(bugprone-unhandled-self-assignment)
+    SharedObject<T> &operator=(const SharedObject<T> &other)
+    {
+        SharedObject<T>(other).Swap(*this);
+        return *this;
+    }
+    SharedObject(SharedObject<T> &&other) noexcept : box_(std::exchange(other.box_, nullptr)) {}
+    SharedObject<T> &operator=(SharedObject<T> &&other) noexcept
+    {
+        SharedObject<T>(std::move(other)).Swap(*this);
+        return *this;
+    }
+
+    T &operator*() const noexcept
+    {
+        return *Get();
+    }
+
+    T *operator->() const noexcept
+    {
+        return Get();
+    }
+
+    T *Get() const
+    {
+        return box_ != nullptr ? box_->GetValue() : nullptr;
+    }
+
+    size_t UseCount() const
+    {
+        return box_ != nullptr ? box_->GetRefCount() : 0;
+    }
+
+    bool IsBiased() const
+    {
+        return box_ != nullptr && box_->IsBiased();
+    }
+
+    void Swap(SharedObject<T> &other) noexcept
+    {
+        std::swap(box_, other.box_);
+    }
+
+private:
+    SharedBox<T> *box_ {nullptr};
+};
+
+/// @brief Creates object biased to the current thread, queued objects of the thread are merged on the way
+template <class T, class... Args>
+SharedObject<T> MakeSharedObject(Args &&...args)
+{
+    BiasedOwner *owner = BiasedOwner::Current();
+    if (UNLIKELY(owner != nullptr && owner->HasQueued())) {
+        owner->ProcessQueue();
+    }
+    return SharedObject<T>(new SharedBox<T>(std::forward<Args>(args)...));
+}
+
+#endif  // MEMORY_MANAGEMENT_REFERECNCE_COUNTING_GC_INCLUDE_SHARED_OBJECT_H
@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include <optional>
+#include <thread>
+#include <vector>
+#include "memory_management/reference_counting_gc/include/deferred_object.h"
+
+namespace {
+
+class ListNode {
+public:
+    explicit ListNode(size_t *deleteCount) : deleteCount_(deleteCount) {}
+    NO_COPY_SEMANTIC(ListNode);
+    NO_MOVE_SEMANTIC(ListNode);
+    ~ListNode()
+    {
+        (*deleteCount_)++;
+    }
+
+    DeferredField<ListNode> next;  // NOLINT(misc-non-private-member-variables-in-classes)
+
+private:
+    size_t *deleteCount_;
+};
+
+}  // namespace
+
+TEST(DeferredReferenceCountingTest, StackReferencesTest)
+{
+    auto &heap = DeferredHeap::Get();
+    heap.Safepoint();
+    size_t deleteCount = 0;
+    {
+        auto node = MakeDeferredObject<ListNode>(&deleteCount);
+        auto copy = node;
+        ASSERT_EQ(copy.Get(), node.Get());
+        // references from the stack are not counted
+        ASSERT_EQ(node.Get()->next.Get(), nullptr);
+        ASSERT_EQ(heap.Safepoint(), 0U);
+        ASSERT_EQ(deleteCount, 0U);
+        ASSERT_EQ(heap.GetZctSize(), 1U);
+    }
+    ASSERT_EQ(deleteCount, 0U);
+    ASSERT_EQ(heap.Safepoint(), 1U);
+    ASSERT_EQ(deleteCount, 1U);
+    ASSERT_EQ(heap.GetZctSize(), 0U);
+}
+
+TEST(DeferredReferenceCountingTest, CoalescingTest)
+{
+    constexpr size_t WRITES_COUNT = 1000000U;
+    auto &heap = DeferredHeap::Get();
+    heap.Safepoint();
+    size_t deleteCount = 0;
+    auto head = MakeDeferredObject<ListNode>(&deleteCount);
+    auto first = MakeDeferredObject<ListNode>(&deleteCount);
+    auto second = MakeDeferredObject<ListNode>(&deleteCount);
+    for (size_t i = 0; i < WRITES_COUNT; i++) {
+        head->next = (i % 2U == 0) ? first : second;
+    }
+    // all writes to the field are coalesced into one log entry
+    ASSERT_EQ(heap.GetLogSize(), 1U);
+    heap.Safepoint();
+    ASSERT_EQ(heap.GetLogSize(), 0U);
+    ASSERT_EQ(second.GetHeader()->GetRefCount(), 1U);
+    ASSERT_EQ(first.GetHeader()->GetRefCount(), 0U);
+
+    head->next = first;
+    head->next = nullptr;
+    heap.Safepoint();
+    ASSERT_EQ(second.GetHeader()->GetRefCount(), 0U);
+    ASSERT_EQ(first.GetHeader()->GetRefCount(), 0U);
+    ASSERT_EQ(deleteCount, 0U);
+}
+
+TEST(DeferredReferenceCountingTest, HeapReferencesTest)
+{
+    constexpr size_t LIST_SIZE = 100000U;
+    auto &heap = DeferredHeap::Get();
+    heap.Safepoint();
+    size_t deleteCount = 0;
+    {
+        auto head = MakeDeferredObject<ListNode>(&deleteCount);
+        {
+            auto tail = head;
+            for (size_t i = 1; i < LIST_SIZE; i++) {
+                auto node = MakeDeferredObject<ListNode>(&deleteCount);
+                tail->next = node;
+                tail = node;
+            }
+        }
+        // the list is alive because its head is on the stack and the rest is referenced from the heap
+        heap.Safepoint();
+        ASSERT_EQ(deleteCount, 0U);
+        ASSERT_EQ(heap.GetZctSize(), 1U);
+
+        size_t length = 0;
+        for (DeferredObject<ListNode> node = head; node.Get() != nullptr; node = node->next) {
+            length++;
+        }
+        ASSERT_EQ(length, LIST_SIZE);
+
+        // cut the list in the middle
+        DeferredObject<ListNode> middle = head;
+        for (size_t i = 1; i < LIST_SIZE / 2U; i++) {
+            middle = middle->next;
+        }
+        middle->next = nullptr;
+        heap.Safepoint();
+        ASSERT_EQ(deleteCount, LIST_SIZE / 2U);
+    }
+    heap.Safepoint();
+    ASSERT_EQ(deleteCount, LIST_SIZE);
+}
+
+TEST(DeferredReferenceCountingTest, DestroyedFieldTest)
+{
+    auto &heap = DeferredHeap::Get();
+    heap.Safepoint();
+    size_t deleteCount = 0;
+    auto target = MakeDeferredObject<ListNode>(&deleteCount);
+    {
+        std::vector<DeferredField<ListNode>> fields;
+        fields.emplace_back(target);
+        // reallocation moves the fields, destroyed fields must not be left in the log
+        for (size_t i = 0; i < 100U; i++) {
+            fields.emplace_back(target);
+        }
+        heap.Safepoint();
+        ASSERT_EQ(target.GetHeader()->GetRefCount(), 101U);
+    }
+    ASSERT_EQ(target.GetHeader()->GetRefCount(), 0U);
+    heap.Safepoint();
+    ASSERT_EQ(deleteCount, 0U);
+}
+
+TEST(DeferredReferenceCountingTest, ThreadExitTest)
+{
+    size_t deleteCount = 0;
+    std::thread([&deleteCount]() {
+        // is constructed before the heap, so it is destroyed after it on thread exit
+        thread_local std::optional<DeferredObject<ListNode>> survivor;
+        ASSERT_FALSE(DeferredHeap::IsDestroyed());
+        survivor.emplace(MakeDeferredObject<ListNode>(&deleteCount));
+        (*survivor)->next = MakeDeferredObject<ListNode>(&deleteCount);
+        // unreachable list is freed by the heap destructor
+        auto head = MakeDeferredObject<ListNode>(&deleteCount);
+        head->next = MakeDeferredObject<ListNode>(&deleteCount);
+    }).join();
+    // objects of the survivor are freed when it is destroyed after the heap
+    ASSERT_EQ(deleteCount, 4U);
+}
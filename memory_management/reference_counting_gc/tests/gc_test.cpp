@@ -2,6 +2,10 @@
 #include "memory_management/reference_counting_gc/include/object_module.h"
 #include "base/macros.h"
 #include "delete_detector.h"
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
 
 class Return42 {
     static constexpr size_t RET_42 = 42U;
@@ -12,7 +16,7 @@ public:
     }
 };
 
-TEST(ReferenceCountingGC, DISABLED_SinglePtrUsage)
+TEST(ReferenceCountingGC, SinglePtrUsage)
 {
     Object<size_t> obj;
     ASSERT_EQ(obj.UseCount(), 0);
@@ -30,7 +34,7 @@ TEST(ReferenceCountingGC, DISABLED_SinglePtrUsage)
     ASSERT_EQ(classObj->Get(), Return42().Get());
 }
 
-TEST(ReferenceCountingGC, DISABLED_CopySemanticUsage)
+TEST(ReferenceCountingGC, CopySemanticUsage)
 {
     constexpr size_t VALUE_TO_CREATE = 42U;
     Object<size_t> obj1 = MakeObject<size_t>(VALUE_TO_CREATE);
@@ -49,7 +53,7 @@ TEST(ReferenceCountingGC, DISABLED_CopySemanticUsage)
     ASSERT_EQ(obj1.UseCount(), 1U);
 }
 
-TEST(ReferenceCountingGC, DISABLED_MoveSemanticUsage)
+TEST(ReferenceCountingGC, MoveSemanticUsage)
 {
     constexpr size_t VALUE_TO_CREATE = 42U;
     Object<size_t> obj1 = MakeObject<size_t>(VALUE_TO_CREATE);
@@ -85,7 +89,7 @@ TEST(ReferenceCountingGC, DISABLED_MoveSemanticUsage)
 }
 
 
-TEST(ReferenceCountingGC, DISABLED_GcDeletingTest) {
+TEST(ReferenceCountingGC, GcDeletingTest) {
     DeleteDetector::SetDeleteCount(0U);
     auto obj1 = MakeObject<DeleteDetector>();
     {
@@ -99,4 +103,373 @@ TEST(ReferenceCountingGC, DISABLED_GcDeletingTest) {
     ASSERT_EQ(DeleteDetector::GetDeleteCount(), 2U);
     obj1->~DeleteDetector();
     ASSERT_EQ(DeleteDetector::GetDeleteCount(), 3U);
-}
\ No newline at end of file
+}
+
+/// Node of a graph which reports its references to the cycle collector
+class GraphNode {
+public:
+    explicit GraphNode(size_t *deleteCount) : deleteCount_(deleteCount) {}
+    NO_COPY_SEMANTIC(GraphNode);
+    NO_MOVE_SEMANTIC(GraphNode);
+    ~GraphNode()
+    {
+        (*deleteCount_)++;
+    }
+
+    void AddEdge(const Object<GraphNode> &node)
+    {
+        edges_.push_back(node);
+    }
+
+    void SetPayload(Object<size_t> payload)
+    {
+        payload_ = std::move(payload);
+    }
+
+    void TraceObjects(ObjectVisitor &visitor) const
+    {
+        for (const auto &edge : edges_) {
+            visitor(edge);
+        }
+        visitor(payload_);
+    }
+
+private:
+    size_t *deleteCount_;
+    std::vector<Object<GraphNode>> edges_;
+    Object<size_t> payload_;
+};
+
+TEST(ReferenceCountingGC, CycleCollectionTest)
+{
+    size_t deleteCount = 0;
+    auto &collector = CycleCollector::Get();
+    {
+        auto self = MakeObject<GraphNode>(&deleteCount);
+        self->AddEdge(self);
+        auto first = MakeObject<GraphNode>(&deleteCount);
+        auto second = MakeObject<GraphNode>(&deleteCount);
+        first->AddEdge(second);
+        second->AddEdge(first);
+        ASSERT_EQ(first.UseCount(), 2U);
+    }
+    ASSERT_EQ(deleteCount, 0U);
+    ASSERT_EQ(collector.GetRootsCount(), 3U);
+    ASSERT_EQ(collector.CollectCycles(), 3U);
+    ASSERT_EQ(deleteCount, 3U);
+    ASSERT_EQ(collector.GetRootsCount(), 0U);
+}
+
+TEST(ReferenceCountingGC, LiveCycleTest)
+{
+    size_t deleteCount = 0;
+    auto &collector = CycleCollector::Get();
+    Object<size_t> payload = MakeObject<size_t>(42U);
+    Object<GraphNode> external;
+    {
+        // long ring which is referenced from outside
+        constexpr size_t RING_SIZE = 100000U;
+        auto head = MakeObject<GraphNode>(&deleteCount);
+        head->SetPayload(payload);
+        auto tail = head;
+        for (size_t i = 1; i < RING_SIZE; i++) {
+            auto node = MakeObject<GraphNode>(&deleteCount);
+            tail->AddEdge(node);
+            tail = node;
+        }
+        tail->AddEdge(head);
+        external = tail;
+    }
+    ASSERT_EQ(collector.CollectCycles(), 0U);
+    ASSERT_EQ(deleteCount, 0U);
+    ASSERT_EQ(external.UseCount(), 2U);
+    ASSERT_EQ(payload.UseCount(), 2U);
+
+    external = Object<GraphNode>();
+    ASSERT_EQ(collector.CollectCycles(), 100000U);
+    ASSERT_EQ(deleteCount, 100000U);
+    // values referenced by the garbage are released as well
+    ASSERT_EQ(payload.UseCount(), 1U);
+}
+
+TEST(ReferenceCountingGC, AutomaticCollectionTest)
+{
+    constexpr size_t CYCLES_COUNT = CycleCollector::DEFAULT_ROOTS_THRESHOLD;
+    size_t deleteCount = 0;
+    for (size_t i = 0; i < CYCLES_COUNT; i++) {
+        auto first = MakeObject<GraphNode>(&deleteCount);
+        auto second = MakeObject<GraphNode>(&deleteCount);
+        first->AddEdge(second);
+        second->AddEdge(first);
+    }
+    // every cycle buffers one root, so the threshold has been reached once
+    ASSERT_EQ(deleteCount, CYCLES_COUNT * 2U);
+    ASSERT_EQ(CycleCollector::Get().GetRootsCount(), 0U);
+}
+
+/// Member of a cycle which copies the reference to its neighbour on destruction
+class CopyOnDeleteNode {
+public:
+    explicit CopyOnDeleteNode(size_t *deleteCount) : deleteCount_(deleteCount) {}
+    NO_COPY_SEMANTIC(CopyOnDeleteNode);
+    NO_MOVE_SEMANTIC(CopyOnDeleteNode);
+    ~CopyOnDeleteNode()
+    {
+        Object<CopyOnDeleteNode> copy = next_;
+        (*deleteCount_)++;
+    }
+
+    void SetNext(Object<CopyOnDeleteNode> next)
+    {
+        next_ = std::move(next);
+    }
+
+    void TraceObjects(ObjectVisitor &visitor) const
+    {
+        visitor(next_);
+    }
+
+private:
+    size_t *deleteCount_;
+    Object<CopyOnDeleteNode> next_;
+};
+
+TEST(ReferenceCountingGC, GarbageCopyTest)
+{
+    size_t deleteCount = 0;
+    auto &collector = CycleCollector::Get();
+    {
+        auto first = MakeObject<CopyOnDeleteNode>(&deleteCount);
+        auto second = MakeObject<CopyOnDeleteNode>(&deleteCount);
+        first->SetNext(second);
+        second->SetNext(first);
+    }
+    ASSERT_EQ(collector.CollectCycles(), 2U);
+    ASSERT_EQ(deleteCount, 2U);
+    // the copies do not buffer freed objects as roots
+    ASSERT_EQ(collector.GetRootsCount(), 0U);
+    ASSERT_EQ(collector.CollectCycles(), 0U);
+}
+
+TEST(ReferenceCountingGC, ThreadExitTest)
+{
+    size_t deleteCount = 0;
+    std::thread([&deleteCount]() {
+        // is constructed before the collector, so it is destroyed after it on thread exit
+        thread_local Object<GraphNode> survivor;
+        ASSERT_FALSE(CycleCollector::IsDestroyed());
+        // the slots cache of the thread is destroyed before too, so the slots are returned to the shared runs
+        survivor = MakeObject<GraphNode>(&deleteCount);
+        survivor->AddEdge(MakeObject<GraphNode>(&deleteCount));
+        // garbage cycle is collected by the collector destructor
+        Object<GraphNode> first(new GraphNode(&deleteCount));
+        Object<GraphNode> second(new GraphNode(&deleteCount));
+        first->AddEdge(second);
+        second->AddEdge(first);
+    }).join();
+    ASSERT_EQ(deleteCount, 4U);
+}
+
+class CopyCounter {
+public:
+    CopyCounter() = default;
+    CopyCounter(const CopyCounter & /* other */)
+    {
+        copies_++;
+    }
+    CopyCounter &operator=(const CopyCounter & /* other */)
+    {
+        copies_++;
+        return *this;
+    }
+    DEFAULT_MOVE_SEMANTIC(CopyCounter);
+    ~CopyCounter() = default;
+
+    static size_t GetCopies()
+    {
+        return copies_;
+    }
+
+private:
+    static inline size_t copies_ = 0;
+};
+
+class ForwardedArgs {
+public:
+    ForwardedArgs(std::unique_ptr<size_t> owned, const CopyCounter &counter, std::string &name)
+        : owned_(std::move(owned)), counter_(counter), name_(name)
+    {
+    }
+
+    size_t GetOwned() const
+    {
+        return *owned_;
+    }
+
+    const std::string &GetName() const
+    {
+        return name_;
+    }
+
+private:
+    std::unique_ptr<size_t> owned_;
+    CopyCounter counter_;
+    std::string &name_;
+};
+
+TEST(ReferenceCountingGC, PerfectForwardingTest)
+{
+    constexpr size_t VALUE = 42U;
+    CopyCounter counter;
+    std::string name = "name";
+    size_t copiesBefore = CopyCounter::GetCopies();
+    auto obj = MakeObject<ForwardedArgs>(std::make_unique<size_t>(VALUE), counter, name);
+    // move-only argument is moved, reference arguments are not copied on the way
+    ASSERT_EQ(obj->GetOwned(), VALUE);
+    ASSERT_EQ(CopyCounter::GetCopies(), copiesBefore + 1U);
+    ASSERT_EQ(&obj->GetName(), &name);
+}
+
+TEST(ReferenceCountingGC, SlotsAllocationTest)
+{
+    constexpr size_t OBJECTS_COUNT = 10000U;
+    auto getUsedSlots = []() {
+        size_t used = 0;
+        for (const auto &sizeClass : ObjectAllocator::GetSlotsAllocator().GetStats().sizeClasses) {
+            used += sizeClass.slotsCount - sizeClass.freeSlotsCount;
+        }
+        return used;
+    };
+    size_t usedBefore = getUsedSlots();
+    DeleteDetector::SetDeleteCount(0U);
+    {
+        std::vector<Object<DeleteDetector>> objects;
+        for (size_t i = 0; i < OBJECTS_COUNT; i++) {
+            objects.push_back(MakeObject<DeleteDetector>());
+        }
+        // control block and value take one slot, the thread cache holds up to its capacity of used slots
+        constexpr size_t CACHE_CAPACITY = ObjectAllocator::SlotsAllocator::ThreadCache::CACHE_CAPACITY;
+        size_t used = getUsedSlots() - usedBefore;
+        ASSERT_GE(used + CACHE_CAPACITY, OBJECTS_COUNT);
+        ASSERT_LE(used, OBJECTS_COUNT + CACHE_CAPACITY);
+        ASSERT_EQ(objects.back().UseCount(), 1U);
+    }
+    ASSERT_EQ(DeleteDetector::GetDeleteCount(), OBJECTS_COUNT);
+    // freed slots are returned to the runs, except the ones kept by the cache
+    ASSERT_LE(getUsedSlots(), usedBefore + ObjectAllocator::SlotsAllocator::ThreadCache::CACHE_CAPACITY);
+
+    // large values do not fit into a slot and are allocated separately
+    auto large = MakeObject<std::array<uint8_t, ObjectAllocator::MAX_SLOT_SIZE>>();
+    ASSERT_EQ(large.UseCount(), 1U);
+    ASSERT_EQ((*large)[0], 0U);
+}
+
+TEST(ReferenceCountingGC, WeakObjectTest)
+{
+    DeleteDetector::SetDeleteCount(0U);
+    WeakObject<DeleteDetector> weak;
+    ASSERT_TRUE(weak.Expired());
+    {
+        auto obj = MakeObject<DeleteDetector>();
+        weak = obj;
+        WeakObject<DeleteDetector> copy(weak);
+        ASSERT_FALSE(copy.Expired());
+        ASSERT_EQ(weak.UseCount(), 1U);
+
+        auto locked = weak.Lock();
+        ASSERT_EQ(locked.Get(), obj.Get());
+        ASSERT_EQ(obj.UseCount(), 2U);
+    }
+    // the value is destroyed while the weak reference keeps the control block
+    ASSERT_EQ(DeleteDetector::GetDeleteCount(), 1U);
+    ASSERT_TRUE(weak.Expired());
+    ASSERT_EQ(weak.UseCount(), 0U);
+    ASSERT_EQ(weak.Lock().Get(), nullptr);
+    weak.Reset();
+    ASSERT_TRUE(weak.Expired());
+
+    // large value is allocated separately, so the weak reference does not hold its memory
+    using Large = std::array<uint8_t, ObjectAllocator::MAX_SLOT_SIZE>;
+    auto large = MakeObject<Large>();
+    WeakObject<Large> weakLarge(large);
+    large = Object<Large>();
+    ASSERT_TRUE(weakLarge.Expired());
+}
+
+/// Member of a cycle which checks its weak peer on destruction
+class WeakPeerNode {
+public:
+    explicit WeakPeerNode(size_t *lockedOnDelete) : lockedOnDelete_(lockedOnDelete) {}
+    NO_COPY_SEMANTIC(WeakPeerNode);
+    NO_MOVE_SEMANTIC(WeakPeerNode);
+    ~WeakPeerNode()
+    {
+        if (peer_.Lock().Get() != nullptr) {
+            (*lockedOnDelete_)++;
+        }
+    }
+
+    void SetNext(Object<WeakPeerNode> next)
+    {
+        peer_ = next;
+        next_ = std::move(next);
+    }
+
+    void TraceObjects(ObjectVisitor &visitor) const
+    {
+        visitor(next_);
+    }
+
+private:
+    size_t *lockedOnDelete_;
+    WeakObject<WeakPeerNode> peer_;
+    Object<WeakPeerNode> next_;
+};
+
+TEST(ReferenceCountingGC, WeakCycleTest)
+{
+    size_t lockedOnDelete = 0;
+    WeakObject<WeakPeerNode> weak;
+    {
+        auto first = MakeObject<WeakPeerNode>(&lockedOnDelete);
+        auto second = MakeObject<WeakPeerNode>(&lockedOnDelete);
+        first->SetNext(second);
+        second->SetNext(first);
+        weak = first;
+    }
+    ASSERT_FALSE(weak.Expired());
+    ASSERT_EQ(CycleCollector::Get().CollectCycles(), 2U);
+    // members of the garbage cycle can not be resurrected by weak references
+    ASSERT_EQ(lockedOnDelete, 0U);
+    ASSERT_TRUE(weak.Expired());
+    ASSERT_EQ(weak.Lock().Get(), nullptr);
+}
+
+TEST(ReferenceCountingGC, WeakCacheTest)
+{
+    constexpr size_t KEYS_COUNT = 16U;
+    std::vector<WeakObject<std::string>> cache(KEYS_COUNT);
+    size_t created = 0;
+    auto get = [&cache, &created](size_t key) {
+        Object<std::string> value = cache[key].Lock();
+        if (value.Get() == nullptr) {
+            value = MakeObject<std::string>(std::to_string(key));
+            cache[key] = value;
+            created++;
+        }
+        return value;
+    };
+    std::vector<Object<std::string>> used;
+    for (size_t key = 0; key < KEYS_COUNT; key++) {
+        used.push_back(get(key));
+        ASSERT_EQ(get(key).Get(), used.back().Get());
+    }
+    ASSERT_EQ(created, KEYS_COUNT);
+    // values which are not used anymore are not kept by the cache
+    used.resize(KEYS_COUNT / 2U);
+    for (size_t key = 0; key < KEYS_COUNT; key++) {
+        ASSERT_EQ(cache[key].Expired(), key >= KEYS_COUNT / 2U);
+        ASSERT_EQ(*get(key), std::to_string(key));
+    }
+    ASSERT_EQ(created, KEYS_COUNT + KEYS_COUNT / 2U);
+}
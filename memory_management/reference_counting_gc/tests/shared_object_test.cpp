@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "memory_management/reference_counting_gc/include/shared_object.h"
+
+namespace {
+
+class Counted {
+public:
+    explicit Counted(std::atomic<size_t> *deleteCount) : deleteCount_(deleteCount) {}
+    NO_COPY_SEMANTIC(Counted);
+    NO_MOVE_SEMANTIC(Counted);
+    ~Counted()
+    {
+        deleteCount_->fetch_add(1U, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<size_t> *deleteCount_;
+};
+
+/// Creates an object on thread exit, after the owner record of the thread is returned
+class ExitProbe {
+public:
+    ExitProbe() = default;
+    NO_COPY_SEMANTIC(ExitProbe);
+    NO_MOVE_SEMANTIC(ExitProbe);
+    ~ExitProbe()
+    {
+        if (deleteCount != nullptr) {
+            *createdBiased = MakeSharedObject<Counted>(deleteCount).IsBiased();
+        }
+    }
+
+    std::atomic<size_t> *deleteCount {nullptr};  // NOLINT(misc-non-private-member-variables-in-classes)
+    bool *createdBiased {nullptr};               // NOLINT(misc-non-private-member-variables-in-classes)
+};
+
+}  // namespace
+
+TEST(BiasedReferenceCountingTest, OwnerThreadTest)
+{
+    std::atomic<size_t> deleteCount {0};
+    {
+        auto obj = MakeSharedObject<Counted>(&deleteCount);
+        ASSERT_TRUE(obj.IsBiased());
+        {
+            auto copy = obj;  // NOLINT(performance-unnecessary-copy-initialization)
+            ASSERT_EQ(obj.UseCount(), 2U);
+            ASSERT_EQ(copy.Get(), obj.Get());
+        }
+        ASSERT_EQ(obj.UseCount(), 1U);
+        ASSERT_TRUE(obj.IsBiased());
+    }
+    ASSERT_EQ(deleteCount.load(), 1U);
+}
+
+TEST(BiasedReferenceCountingTest, ReleaseInOtherThreadTest)
+{
+    std::atomic<size_t> deleteCount {0};
+    auto obj = MakeSharedObject<Counted>(&deleteCount);
+    auto copy = obj;
+    // the reference created by the owner is released by the other thread, so the shared count becomes negative
+    std::thread([moved = std::move(copy)]() mutable { moved = SharedObject<Counted>(); }).join();
+    ASSERT_EQ(obj.UseCount(), 1U);
+    ASSERT_TRUE(obj.IsBiased());
+    ASSERT_EQ(BiasedOwner::Current()->ProcessQueue(), 1U);
+    ASSERT_FALSE(obj.IsBiased());
+    ASSERT_EQ(obj.UseCount(), 1U);
+    obj = SharedObject<Counted>();
+    ASSERT_EQ(deleteCount.load(), 1U);
+
+    // the other thread takes its own reference, the owner drops its references first and merges the counts
+    auto other = MakeSharedObject<Counted>(&deleteCount);
+    std::atomic<int> stage {0};
+    std::thread worker([&other, &stage]() {
+        SharedObject<Counted> copy = other;
+        stage.store(1);
+        while (stage.load() != 2) {
+            std::this_thread::yield();
+        }
+        // the last reference is released by the other thread
+    });
+    while (stage.load() != 1) {
+        std::this_thread::yield();
+    }
+    other = SharedObject<Counted>();
+    ASSERT_EQ(deleteCount.load(), 1U);
+    stage.store(2);
+    worker.join();
+    ASSERT_EQ(deleteCount.load(), 2U);
+}
+
+TEST(BiasedReferenceCountingTest, FinishedOwnerTest)
+{
+    constexpr size_t ROUNDS_COUNT = 1000U;
+    std::atomic<size_t> deleteCount {0};
+    for (size_t i = 0; i < ROUNDS_COUNT; i++) {
+        SharedObject<Counted> handed;
+        // the owner hands its object off and exits, so its record has no owner when the object is released
+        std::thread([&handed, &deleteCount]() { handed = MakeSharedObject<Counted>(&deleteCount); }).join();
+        ASSERT_TRUE(handed.IsBiased());
+        handed = SharedObject<Counted>();
+        ASSERT_EQ(deleteCount.load(), i + 1U);
+    }
+}
+
+TEST(BiasedReferenceCountingTest, ThreadExitTest)
+{
+    std::atomic<size_t> deleteCount {0};
+    bool createdBiased = true;
+    SharedObject<Counted> handed;
+    std::thread([&handed, &deleteCount, &createdBiased]() {
+        // are constructed before the first MakeSharedObject, so they are destroyed after the record is returned
+        thread_local ExitProbe probe;
+        thread_local SharedObject<Counted> survivor;
+        probe.deleteCount = &deleteCount;
+        probe.createdBiased = &createdBiased;
+        survivor = MakeSharedObject<Counted>(&deleteCount);
+        handed = survivor;
+    }).join();
+    // the finished thread does not take a record again, its object is counted by the shared count
+    ASSERT_FALSE(createdBiased);
+    ASSERT_EQ(deleteCount.load(), 1U);
+    ASSERT_EQ(handed.UseCount(), 1U);
+    handed = SharedObject<Counted>();
+    ASSERT_EQ(deleteCount.load(), 2U);
+}
+
+TEST(BiasedReferenceCountingTest, MultithreadingTest)
+{
+    constexpr size_t THREADS_COUNT = 8U;
+    constexpr size_t OBJECTS_COUNT = 1000U;
+    constexpr size_t COPIES_COUNT = 100U;
+    std::atomic<size_t> deleteCount {0};
+    {
+        std::vector<SharedObject<Counted>> objects;
+        for (size_t i = 0; i < OBJECTS_COUNT; i++) {
+            objects.push_back(MakeSharedObject<Counted>(&deleteCount));
+        }
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < THREADS_COUNT; i++) {
+            threads.emplace_back([objects]() mutable {
+                // every thread creates its own objects as well and shares them with the owner of the others
+                std::vector<SharedObject<Counted>> copies;
+                for (size_t j = 0; j < COPIES_COUNT; j++) {
+                    for (auto &obj : objects) {
+                        copies.push_back(obj);
+                    }
+                    copies.clear();
+                }
+                objects.clear();
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        ASSERT_EQ(deleteCount.load(), 0U);
+        for (auto &obj : objects) {
+            ASSERT_EQ(obj.UseCount(), 1U);
+        }
+    }
+    BiasedOwner::Current()->ProcessQueue();
+    ASSERT_EQ(deleteCount.load(), OBJECTS_COUNT);
+}
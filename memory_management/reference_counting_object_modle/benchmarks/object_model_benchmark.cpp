@@ -0,0 +1,153 @@
+/**
+ * Throughput of the reference counting and the tracing backends of the object model.
+ * binary_trees allocates short-lived trees while a long-lived tree is alive, pointer_writes stores references into
+ * fields of live objects. Time of the tracing backend includes the final collection.
+ * Usage: object_model_benchmark [--ops <count>]
+ */
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+#include "memory_management/reference_counting_object_modle/include/object_modle.h"
+#include "memory_management/reference_counting_object_modle/include/traced_object.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t DEFAULT_OPS = 2000000U;
+constexpr size_t LONG_LIVED_DEPTH = 16U;
+constexpr size_t SHORT_LIVED_DEPTH = 8U;
+constexpr size_t LIVE_NODES = 65536U;
+
+struct RcBackend {
+    static constexpr const char *NAME = "reference counting";
+
+    struct Node {
+        Object<Node> left;
+        Object<Node> right;
+    };
+    using Handle = Object<Node>;
+
+    static Handle New()
+    {
+        return MakeObject<Node>();
+    }
+
+    static void Collect() {}
+};
+
+struct TracingBackend {
+    static constexpr const char *NAME = "mark-sweep";
+
+    struct Node {
+        TracedField<Node> left;
+        TracedField<Node> right;
+
+        static constexpr std::array<size_t, 2U> GetTracedFields()
+        {
+            return {MEMBER_OFFSET(Node, left), MEMBER_OFFSET(Node, right)};
+        }
+    };
+    using Handle = TracedObject<Node>;
+
+    static Handle New()
+    {
+        return MakeTracedObject<Node>();
+    }
+
+    static void Collect()
+    {
+        TracingHeap::Get().Collect();
+    }
+};
+
+template <class Backend>
+typename Backend::Handle BuildTree(size_t depth)
+{
+    auto node = Backend::New();
+    if (depth > 0) {
+        node->left = BuildTree<Backend>(depth - 1U);
+        node->right = BuildTree<Backend>(depth - 1U);
+    }
+    return node;
+}
+
+/// @returns allocated objects per second
+template <class Backend>
+double RunBinaryTrees(size_t ops)
+{
+    constexpr size_t TREE_SIZE = (size_t(1) << (SHORT_LIVED_DEPTH + 1U)) - 1U;
+    auto lived = BuildTree<Backend>(LONG_LIVED_DEPTH);
+    Backend::Collect();
+    size_t trees = ops / TREE_SIZE;
+    auto start = Clock::now();
+    for (size_t i = 0; i < trees; i++) {
+        BuildTree<Backend>(SHORT_LIVED_DEPTH);
+    }
+    Backend::Collect();
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+    return static_cast<double>(trees * TREE_SIZE) / elapsed.count();
+}
+
+/// @returns stores per second
+template <class Backend>
+double RunPointerWrites(size_t ops)
+{
+    std::vector<typename Backend::Handle> nodes;
+    nodes.reserve(LIVE_NODES);
+    for (size_t i = 0; i < LIVE_NODES; i++) {
+        nodes.push_back(Backend::New());
+    }
+    std::mt19937 gen(1U);
+    std::vector<uint32_t> targets(ops);
+    for (auto &target : targets) {
+        target = static_cast<uint32_t>(gen() % LIVE_NODES);
+    }
+    auto start = Clock::now();
+    for (size_t i = 0; i < ops; i++) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+        nodes[i % LIVE_NODES]->left = nodes[targets[i]];
+    }
+    Backend::Collect();
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+    return static_cast<double>(ops) / elapsed.count();
+}
+
+void PrintResult(const char *workload, const char *backend, double opsPerSecond)
+{
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+    std::printf("%-16s %-20s %10.2f\n", workload, backend, opsPerSecond / 1e6);
+}
+
+template <class... Backends>
+void RunAll(size_t ops)
+{
+    (PrintResult("binary_trees", Backends::NAME, RunBinaryTrees<Backends>(ops)), ...);
+    (PrintResult("pointer_writes", Backends::NAME, RunPointerWrites<Backends>(ops)), ...);
+}
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    size_t ops = DEFAULT_OPS;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        if (arg == "--ops" && i + 1 < argc) {
+            ops = std::strtoull(argv[++i], nullptr, 10);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        } else {
+            std::fprintf(stderr, "usage: %s [--ops <count>]\n", argv[0]);  // NOLINT
+            return 1;
+        }
+    }
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+    std::printf("%-16s %-20s %10s\n", "workload", "backend", "Mops/s");
+    RunAll<RcBackend, TracingBackend>(ops);
+    return 0;
+}
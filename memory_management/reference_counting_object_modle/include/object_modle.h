@@ -1,83 +1,1062 @@
 #ifndef MEMORY_MANAGEMENT_REFERECNCE_COUNTING_OBJECT_MODLE_INCLUDE_OBJECT_MODLE_H
 #define MEMORY_MANAGEMENT_REFERECNCE_COUNTING_OBJECT_MODLE_INCLUDE_OBJECT_MODLE_H
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
 #include <cstddef>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <sys/mman.h>
+#include "base/macros.h"
 
 template <class T>
 class Object;
 
 template <class T, class... Args>
-static Object<T> MakeObject([[maybe_unused]] Args... args)
-{
-    // TODO(you): Implement this function
-    return {};
-}
+Object<T> MakeObject(Args &&...args);
+
+/// Description of the value type which is shared by all objects of the type, header refers to it by 32-bit id
+struct TypeDescriptor {
+    size_t size {0};
+    void (*destroy)(void *value) {nullptr};
+    const size_t *fields {nullptr};  // offsets of references which are traced by the collector
+    size_t fieldsCount {0};
+};
+
+/// Field map of T, the type lists offsets of its traced references in static constexpr GetTracedFields()
+template <class T, class = void>
+struct FieldMap {
+    static constexpr std::array<size_t, 0> OFFSETS {};
+};
 
-// TODO(you): Implement object base on java object representatoin
+template <class T>
+struct FieldMap<T, std::void_t<decltype(T::GetTracedFields())>> {
+    static constexpr auto OFFSETS = T::GetTracedFields();
+};
+
+/// Table of type descriptors, id of the type is its index, so the header keeps a compressed class pointer
+class TypeRegistry {
+public:
+    static constexpr size_t MAX_TYPES = 4096U;
+
+    template <class T>
+    static uint32_t GetId()
+    {
+        static const uint32_t ID = Register({sizeof(T), [](void *value) { static_cast<T *>(value)->~T(); },
+                                             FieldMap<T>::OFFSETS.data(), FieldMap<T>::OFFSETS.size()});
+        return ID;
+    }
+
+    static const TypeDescriptor &Get(uint32_t id)
+    {
+        return GetTable().types[id];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+    }
+
+private:
+    struct Table {
+        std::mutex lock;
+        std::array<TypeDescriptor, MAX_TYPES> types {};
+        uint32_t count {0};
+    };
+
+    static Table &GetTable()
+    {
+        static Table table;
+        return table;
+    }
+
+    static uint32_t Register(TypeDescriptor descriptor)
+    {
+        Table &table = GetTable();
+        std::lock_guard lock(table.lock);
+        if (UNLIKELY(table.count == MAX_TYPES)) {
+            throw std::bad_alloc();
+        }
+        table.types[table.count] = descriptor;  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+        return table.count++;
+    }
+};
+
+/**
+ * Memory of objects. If PROJECT_ENABLE_COMPRESSED_REFERENCES is set, the heap is a range of RESERVED_SIZE (4 GiB)
+ * bytes which is reserved up front, and a reference is a 32-bit offset from the heap base in units of object
+ * alignment. Otherwise the heap is the global operator new and a reference is a raw pointer.
+ */
+class ObjectHeap {
+public:
+#ifdef PROJECT_ENABLE_COMPRESSED_REFERENCES
+    using Reference = uint32_t;
+
+    static constexpr size_t ALIGNMENT_SHIFT = 4U;
+    static constexpr size_t ALIGNMENT = size_t(1) << ALIGNMENT_SHIFT;
+    static constexpr size_t RESERVED_SIZE = size_t(4) << 30U;
+    static_assert(RESERVED_SIZE <= (size_t(UINT32_MAX) + 1U) << ALIGNMENT_SHIFT);
+
+    static void *Allocate(size_t size)
+    {
+        return Get().AllocateBlock(GetGranules(size));
+    }
+
+    static void Free(void *memory, size_t size)
+    {
+        Get().FreeBlock(Compress(memory), GetGranules(size));
+    }
+
+    static Reference Compress(const void *ptr)
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        return ptr != nullptr ? static_cast<Reference>((reinterpret_cast<uintptr_t>(ptr) - base_) >> ALIGNMENT_SHIFT)
+                              : 0;
+    }
+
+    static void *Decompress(Reference ref)
+    {
+        // the heap is reserved before the first reference is created, offset 0 is never allocated
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast, performance-no-int-to-ptr)
+        return ref != 0 ? reinterpret_cast<void *>(base_ + (static_cast<uintptr_t>(ref) << ALIGNMENT_SHIFT)) : nullptr;
+    }
+
+    /// @returns bytes taken from the reserved range by the bump pointer, free blocks below it are counted too
+    static size_t GetUsedSize()
+    {
+        ObjectHeap &heap = Get();
+        std::lock_guard lock(heap.lock_);
+        return static_cast<size_t>(heap.top_) << ALIGNMENT_SHIFT;
+    }
+
+    /// @returns bytes of the reserved range which are made readable and writable
+    static size_t GetCommittedSize()
+    {
+        ObjectHeap &heap = Get();
+        std::lock_guard lock(heap.lock_);
+        return heap.committed_ << ALIGNMENT_SHIFT;
+    }
+
+    ~ObjectHeap() = default;
+    NO_COPY_SEMANTIC(ObjectHeap);
+    NO_MOVE_SEMANTIC(ObjectHeap);
+
+private:
+    // blocks up to SMALL_GRANULES are kept in free lists of exact size, every list has its own lock
+    static constexpr size_t SMALL_GRANULES = 256U;
+    // larger blocks are kept in lists of power of two size classes, they are split on allocation
+    static constexpr size_t LARGE_CLASSES = 32U;
+    static constexpr size_t BITS_IN_SIZE = sizeof(size_t) * 8U;
+    static constexpr size_t MAX_GRANULES = RESERVED_SIZE >> ALIGNMENT_SHIFT;
+    // the reserved range is inaccessible, it is made readable and writable by chunks as the top grows
+    static constexpr size_t COMMIT_GRANULES = (size_t(1) << 20U) >> ALIGNMENT_SHIFT;
+
+    struct SmallList {
+        std::mutex lock;
+        Reference head {0};
+    };
+
+    // is placed in the first granule of a free large block
+    struct LargeBlock {
+        Reference next;
+        uint32_t granules;
+    };
+    static_assert(sizeof(LargeBlock) <= ALIGNMENT);
+
+    ObjectHeap()
+    {
+        void *mem = mmap(nullptr, RESERVED_SIZE, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (mem == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        base_ = reinterpret_cast<uintptr_t>(mem);  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    }
+
+    static ObjectHeap &Get()
+    {
+        // is never destroyed, so objects can be released by destructors of static variables
+        static auto *heap = new ObjectHeap();
+        return *heap;
+    }
+
+    static size_t GetGranules(size_t size)
+    {
+        return (size + ALIGNMENT - 1U) >> ALIGNMENT_SHIFT;
+    }
+
+    static size_t GetLargeClass(size_t granules)
+    {
+        return BITS_IN_SIZE - 1U - static_cast<size_t>(__builtin_clzll(granules));
+    }
+
+    static Reference &NextFree(Reference block)
+    {
+        return *static_cast<Reference *>(Decompress(block));
+    }
+
+    static LargeBlock *GetLargeBlock(Reference block)
+    {
+        return static_cast<LargeBlock *>(Decompress(block));
+    }
+
+    void *AllocateBlock(size_t granules)
+    {
+        if (granules <= SMALL_GRANULES) {
+            SmallList &list = smallFree_[granules - 1U];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+            std::lock_guard lock(list.lock);
+            if (list.head != 0) {
+                Reference block = list.head;
+                list.head = NextFree(block);
+                return Decompress(block);
+            }
+        }
+        std::lock_guard lock(lock_);
+        if (granules > SMALL_GRANULES) {
+            if (Reference block = TakeLarge(granules); block != 0) {
+                return Decompress(block);
+            }
+        }
+        return Decompress(Bump(granules));
+    }
+
+    void FreeBlock(Reference block, size_t granules)
+    {
+        if (granules <= SMALL_GRANULES) {
+            PushSmall(block, granules);
+            return;
+        }
+        std::lock_guard lock(lock_);
+        if (block + granules == top_) {
+            // the last block returns to the bump pointer, so it can be taken by an allocation of any size
+            top_ = block;
+            return;
+        }
+        PushLarge(block, granules);
+    }
+
+    /// @brief Is called under lock_
+    Reference Bump(size_t granules)
+    {
+        if (granules > MAX_GRANULES - top_) {
+            throw std::bad_alloc();
+        }
+        size_t newTop = top_ + granules;
+        if (newTop > committed_) {
+            size_t commitEnd = (newTop + COMMIT_GRANULES - 1U) / COMMIT_GRANULES * COMMIT_GRANULES;
+            commitEnd = std::min(commitEnd, MAX_GRANULES);
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast, performance-no-int-to-ptr)
+            void *begin = reinterpret_cast<void *>(base_ + (committed_ << ALIGNMENT_SHIFT));
+            if (mprotect(begin, (commitEnd - committed_) << ALIGNMENT_SHIFT, PROT_READ | PROT_WRITE) != 0) {
+                throw std::bad_alloc();
+            }
+            committed_ = commitEnd;
+        }
+        auto block = static_cast<Reference>(top_);
+        top_ = newTop;
+        return block;
+    }
+
+    /**
+     * @brief Takes the first large block which fits, its tail is returned to the free lists. Is called under lock_.
+     * @returns the block or 0 if there is no fitting block
+     */
+    Reference TakeLarge(size_t granules)
+    {
+        for (size_t sizeClass = GetLargeClass(granules); sizeClass < LARGE_CLASSES; sizeClass++) {
+            // blocks of the larger classes always fit, so only the class of the request is scanned
+            Reference *link = &largeFree_[sizeClass];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+            while (*link != 0 && GetLargeBlock(*link)->granules < granules) {
+                link = &GetLargeBlock(*link)->next;
+            }
+            if (*link == 0) {
+                continue;
+            }
+            Reference block = *link;
+            size_t blockGranules = GetLargeBlock(block)->granules;
+            *link = GetLargeBlock(block)->next;
+            if (blockGranules > granules) {
+                auto rest = static_cast<Reference>(block + granules);
+                size_t restGranules = blockGranules - granules;
+                if (restGranules <= SMALL_GRANULES) {
+                    PushSmall(rest, restGranules);
+                } else {
+                    PushLarge(rest, restGranules);
+                }
+            }
+            return block;
+        }
+        return 0;
+    }
+
+    void PushSmall(Reference block, size_t granules)
+    {
+        SmallList &list = smallFree_[granules - 1U];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+        std::lock_guard lock(list.lock);
+        NextFree(block) = list.head;
+        list.head = block;
+    }
+
+    /// @brief Is called under lock_
+    void PushLarge(Reference block, size_t granules)
+    {
+        Reference &head = largeFree_[GetLargeClass(granules)];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+        *GetLargeBlock(block) = LargeBlock {head, static_cast<uint32_t>(granules)};
+        head = block;
+    }
+
+    static inline uintptr_t base_ {0};
+
+    std::mutex lock_;  // guards the bump pointer and the large blocks
+    size_t top_ {1U};  // in granules, the first granule is not used, so 0 is the null reference
+    size_t committed_ {0};
+    std::array<SmallList, SMALL_GRANULES> smallFree_ {};
+    std::array<Reference, LARGE_CLASSES> largeFree_ {};
+#else
+    using Reference = void *;
+
+    static void *Allocate(size_t size)
+    {
+        return ::operator new(size);
+    }
+
+    static void Free(void *memory, [[maybe_unused]] size_t size)
+    {
+        ::operator delete(memory);
+    }
+
+    static Reference Compress(const void *ptr)
+    {
+        return const_cast<void *>(ptr);  // NOLINT(cppcoreguidelines-pro-type-const-cast)
+    }
+
+    static void *Decompress(Reference ref)
+    {
+        return ref;
+    }
+#endif
+};
+
+/**
+ * Mark word of the object header:
+ *  63            34   33     32     31            2   1    0
+ * [ reference count | gc bits  ] [ lock payload    | lock state ]
+ * Lock payload depends on the lock state:
+ *   UNLOCKED - identity hash or 0 if it is not generated yet
+ *   THIN     - id of the owner thread in the low 16 bits and count of recursive locks above it
+ *   INFLATED - index of the monitor in MonitorTable, the monitor keeps the identity hash
+ */
+class MarkWord {
+public:
+    enum class LockState : uint8_t { UNLOCKED = 0, THIN = 1, INFLATED = 2 };
+
+    static constexpr uint64_t LOCK_STATE_MASK = 0x3U;
+    static constexpr uint64_t PAYLOAD_SHIFT = 2U;
+    static constexpr uint64_t PAYLOAD_BITS = 30U;
+    static constexpr uint64_t PAYLOAD_MASK = ((uint64_t(1) << PAYLOAD_BITS) - 1U) << PAYLOAD_SHIFT;
+    static constexpr uint32_t THIN_OWNER_BITS = 16U;
+    static constexpr uint32_t THIN_OWNER_MASK = (uint32_t(1) << THIN_OWNER_BITS) - 1U;
+    static constexpr uint32_t MAX_THIN_RECURSION = (uint32_t(1) << (PAYLOAD_BITS - THIN_OWNER_BITS)) - 1U;
+    static constexpr uint64_t MARK_BIT = uint64_t(1) << 32U;
+    static constexpr uint64_t REF_COUNT_SHIFT = 34U;
+    static constexpr uint64_t REF_COUNT_ONE = uint64_t(1) << REF_COUNT_SHIFT;
+
+    static LockState GetLockState(uint64_t word)
+    {
+        return static_cast<LockState>(word & LOCK_STATE_MASK);
+    }
+
+    static uint32_t GetPayload(uint64_t word)
+    {
+        return static_cast<uint32_t>((word & PAYLOAD_MASK) >> PAYLOAD_SHIFT);
+    }
+
+    static uint64_t SetPayload(uint64_t word, uint32_t payload)
+    {
+        return (word & ~PAYLOAD_MASK) | ((uint64_t(payload) << PAYLOAD_SHIFT) & PAYLOAD_MASK);
+    }
+
+    static uint64_t SetLock(uint64_t word, LockState state, uint32_t payload)
+    {
+        return SetPayload(word & ~LOCK_STATE_MASK, payload) | static_cast<uint64_t>(state);
+    }
+
+    static uint32_t GetThinOwner(uint64_t word)
+    {
+        return GetPayload(word) & THIN_OWNER_MASK;
+    }
+
+    static uint32_t GetThinRecursion(uint64_t word)
+    {
+        return GetPayload(word) >> THIN_OWNER_BITS;
+    }
+
+    static uint32_t MakeThinPayload(uint32_t owner, uint32_t recursion)
+    {
+        return owner | (recursion << THIN_OWNER_BITS);
+    }
+
+    static uint32_t GetRefCount(uint64_t word)
+    {
+        return static_cast<uint32_t>(word >> REF_COUNT_SHIFT);
+    }
+};
+
+/// Small ids of live threads which fit into the thin lock, ids of finished threads are reused
+class LockOwnerId {
+public:
+    static constexpr uint32_t MAX_ID = MarkWord::THIN_OWNER_MASK;
+
+    /**
+     * @returns id of the current thread, it is never 0
+     * @throws std::bad_alloc if MAX_ID threads are alive
+     */
+    static uint32_t Current()
+    {
+        thread_local Holder holder;
+        return holder.id;
+    }
+
+private:
+    struct Pool {
+        std::mutex lock;
+        std::vector<uint32_t> free;
+        uint32_t next {1U};
+    };
+
+    struct Holder {
+        Holder()
+        {
+            Pool &pool = GetPool();
+            std::lock_guard lock(pool.lock);
+            if (pool.free.empty()) {
+                if (UNLIKELY(pool.next > MAX_ID)) {
+                    throw std::bad_alloc();
+                }
+                id = pool.next++;
+            } else {
+                id = pool.free.back();
+                pool.free.pop_back();
+            }
+        }
+        ~Holder()
+        {
+            Pool &pool = GetPool();
+            std::lock_guard lock(pool.lock);
+            pool.free.push_back(id);
+        }
+        NO_COPY_SEMANTIC(Holder);
+        NO_MOVE_SEMANTIC(Holder);
+
+        uint32_t id {0};
+    };
+
+    static Pool &GetPool()
+    {
+        static Pool pool;
+        return pool;
+    }
+};
+
+/**
+ * Fat lock of the object, it is used when the thin lock is contended. The monitor is deflated on the last exit if
+ * nobody waits for it, the identity hash is moved back to the mark word, then its index can be reused by another
+ * object. A thread which has read the index from the mark word checks under the monitor lock that the mark word
+ * still refers to it.
+ */
+class Monitor {
+public:
+    enum class EnterResult : uint8_t { ENTERED, BUSY, DEFLATED };
+
+    Monitor() = default;
+    ~Monitor() = default;
+    NO_COPY_SEMANTIC(Monitor);
+    NO_MOVE_SEMANTIC(Monitor);
+
+    /// @brief Takes state of the thin lock and the identity hash, is called before the monitor is published
+    void Init(uint32_t owner, uint32_t recursion, uint32_t hash)
+    {
+        std::lock_guard lock(lock_);
+        owner_ = owner;
+        recursion_ = recursion;
+        waiters_ = 0;
+        hash_ = hash;
+    }
+
+    /**
+     * @brief Enters the monitor with @param index which was read from @param markWord, waits if it is owned
+     * @returns false if the monitor was deflated, the caller rereads the mark word
+     */
+    bool Enter(uint32_t thread, const std::atomic<uint64_t> &markWord, uint32_t index)
+    {
+        std::unique_lock lock(lock_);
+        if (!IsBound(markWord, index)) {
+            return false;
+        }
+        if (owner_ == thread) {
+            recursion_++;
+            return true;
+        }
+        // monitor with waiters is not deflated, so it stays bound to the object
+        waiters_++;
+        while (owner_ != 0) {
+            released_.wait(lock);
+        }
+        waiters_--;
+        owner_ = thread;
+        recursion_ = 1U;
+        return true;
+    }
+
+    EnterResult TryEnter(uint32_t thread, const std::atomic<uint64_t> &markWord, uint32_t index)
+    {
+        std::lock_guard lock(lock_);
+        if (!IsBound(markWord, index)) {
+            return EnterResult::DEFLATED;
+        }
+        if (owner_ != 0 && owner_ != thread) {
+            return EnterResult::BUSY;
+        }
+        owner_ = thread;
+        recursion_++;
+        return EnterResult::ENTERED;
+    }
+
+    /**
+     * @brief Exits the monitor, the last exit without waiters unlocks @param markWord by CAS and keeps the hash in it
+     * @returns true if the monitor is deflated, the caller frees its index
+     */
+    bool Exit([[maybe_unused]] uint32_t thread, std::atomic<uint64_t> &markWord)
+    {
+        std::lock_guard lock(lock_);
+        assert(owner_ == thread && recursion_ > 0);
+        if (--recursion_ != 0) {
+            return false;
+        }
+        owner_ = 0;
+        if (waiters_ != 0) {
+            released_.notify_one();
+            return false;
+        }
+        // only count and gc bits can be changed concurrently, the lock bits belong to the owner of the monitor
+        uint64_t word = markWord.load(std::memory_order_relaxed);
+        while (!markWord.compare_exchange_weak(word, MarkWord::SetLock(word, MarkWord::LockState::UNLOCKED, hash_),
+                                               std::memory_order_release, std::memory_order_relaxed)) {
+        }
+        return true;
+    }
+
+    /**
+     * @returns identity hash, @param hash is set if the hash is not generated yet.
+     * Returns 0 if the monitor was deflated, the caller rereads the mark word.
+     */
+    uint32_t GetOrSetHash(uint32_t hash, const std::atomic<uint64_t> &markWord, uint32_t index)
+    {
+        std::lock_guard lock(lock_);
+        if (!IsBound(markWord, index)) {
+            return 0;
+        }
+        if (hash_ == 0) {
+            hash_ = hash;
+        }
+        return hash_;
+    }
+
+private:
+    static bool IsBound(const std::atomic<uint64_t> &markWord, uint32_t index)
+    {
+        uint64_t word = markWord.load(std::memory_order_acquire);
+        return MarkWord::GetLockState(word) == MarkWord::LockState::INFLATED && MarkWord::GetPayload(word) == index;
+    }
+
+    std::mutex lock_;
+    std::condition_variable released_;
+    uint32_t owner_ {0};
+    uint32_t recursion_ {0};
+    uint32_t waiters_ {0};
+    uint32_t hash_ {0};
+};
+
+/// Side table of monitors, monitors are kept in chunks, so index lookup needs no lock
+class MonitorTable {
+public:
+    static constexpr size_t CHUNK_SIZE = 1024U;
+    static constexpr size_t MAX_CHUNKS = 1024U;
+
+    static MonitorTable &Get()
+    {
+        // is never destroyed, so objects can be unlocked by destructors of static variables
+        static auto *table = new MonitorTable();
+        return *table;
+    }
+
+    uint32_t Allocate()
+    {
+        std::lock_guard lock(lock_);
+        if (!free_.empty()) {
+            uint32_t index = free_.back();
+            free_.pop_back();
+            return index;
+        }
+        size_t chunk = count_ / CHUNK_SIZE;
+        if (UNLIKELY(chunk == MAX_CHUNKS)) {
+            throw std::bad_alloc();
+        }
+        if (count_ % CHUNK_SIZE == 0) {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+            chunks_[chunk].store(new std::array<Monitor, CHUNK_SIZE>(), std::memory_order_release);
+        }
+        return count_++;
+    }
+
+    void Free(uint32_t index)
+    {
+        std::lock_guard lock(lock_);
+        free_.push_back(index);
+    }
+
+    Monitor &GetMonitor(uint32_t index)
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+        return (*chunks_[index / CHUNK_SIZE].load(std::memory_order_acquire))[index % CHUNK_SIZE];
+    }
+
+    ~MonitorTable() = default;
+    NO_COPY_SEMANTIC(MonitorTable);
+    NO_MOVE_SEMANTIC(MonitorTable);
+
+private:
+    MonitorTable() = default;
+
+    std::mutex lock_;
+    std::vector<uint32_t> free_;
+    uint32_t count_ {0};
+    std::array<std::atomic<std::array<Monitor, CHUNK_SIZE> *>, MAX_CHUNKS> chunks_ {};
+};
+
+/// Header which is placed right before the value, value is aligned by the header size
+class alignas(16) ObjectHeader {
+public:
+    explicit ObjectHeader(uint32_t typeId) : typeId_(typeId) {}
+    ~ObjectHeader() = default;
+    NO_COPY_SEMANTIC(ObjectHeader);
+    NO_MOVE_SEMANTIC(ObjectHeader);
+
+    template <class T>
+    static ObjectHeader *FromValue(T *value)
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        return reinterpret_cast<ObjectHeader *>(reinterpret_cast<uint8_t *>(value) - sizeof(ObjectHeader));
+    }
+
+    void *GetValue()
+    {
+        return this + 1;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    void IncRef()
+    {
+        markWord_.fetch_add(MarkWord::REF_COUNT_ONE, std::memory_order_relaxed);
+    }
+
+    /// @returns true if the last reference is released
+    bool DecRef()
+    {
+        return MarkWord::GetRefCount(markWord_.fetch_sub(MarkWord::REF_COUNT_ONE, std::memory_order_acq_rel)) == 1U;
+    }
+
+    uint32_t GetRefCount() const
+    {
+        return MarkWord::GetRefCount(markWord_.load(std::memory_order_relaxed));
+    }
+
+    /// @returns identity hash which is generated on the first call, it is never 0
+    uint32_t GetHashCode()
+    {
+        uint64_t word = markWord_.load(std::memory_order_acquire);
+        while (true) {
+            switch (MarkWord::GetLockState(word)) {
+                case MarkWord::LockState::UNLOCKED: {
+                    uint32_t hash = MarkWord::GetPayload(word);
+                    if (hash != 0) {
+                        return hash;
+                    }
+                    uint64_t hashed = MarkWord::SetPayload(word, GenerateHash());
+                    if (markWord_.compare_exchange_weak(word, hashed, std::memory_order_relaxed)) {
+                        return MarkWord::GetPayload(hashed);
+                    }
+                    break;
+                }
+                case MarkWord::LockState::THIN:
+                    // thin lock occupies the payload, so the hash moves to the monitor
+                    Inflate(word);
+                    word = markWord_.load(std::memory_order_acquire);
+                    break;
+                default: {
+                    uint32_t hash = GetMonitor(word).GetOrSetHash(GenerateHash(), markWord_, MarkWord::GetPayload(word));
+                    if (hash != 0) {
+                        return hash;
+                    }
+                    word = markWord_.load(std::memory_order_acquire);
+                    break;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Takes the thin lock by CAS if the object is not locked. Contended, hashed or too deeply recursive lock
+     * is inflated to the monitor, the monitor is deflated when it is released by all threads.
+     */
+    void Lock()
+    {
+        uint32_t thread = LockOwnerId::Current();
+        size_t spins = 0;
+        uint64_t word = markWord_.load(std::memory_order_relaxed);
+        while (true) {
+            switch (MarkWord::GetLockState(word)) {
+                case MarkWord::LockState::UNLOCKED:
+                    if (MarkWord::GetPayload(word) != 0) {
+                        Inflate(word);
+                        word = markWord_.load(std::memory_order_acquire);
+                        break;
+                    }
+                    if (markWord_.compare_exchange_weak(word, ThinLocked(word, thread, 0),
+                                                        std::memory_order_acquire)) {
+                        return;
+                    }
+                    break;
+                case MarkWord::LockState::THIN:
+                    if (MarkWord::GetThinOwner(word) == thread &&
+                        MarkWord::GetThinRecursion(word) < MarkWord::MAX_THIN_RECURSION) {
+                        uint64_t locked = ThinLocked(word, thread, MarkWord::GetThinRecursion(word) + 1U);
+                        if (markWord_.compare_exchange_weak(word, locked, std::memory_order_relaxed)) {
+                            return;
+                        }
+                        break;
+                    }
+                    if (MarkWord::GetThinOwner(word) != thread && ++spins < SPINS_BEFORE_INFLATION) {
+                        std::this_thread::yield();
+                        word = markWord_.load(std::memory_order_relaxed);
+                        break;
+                    }
+                    Inflate(word);
+                    word = markWord_.load(std::memory_order_acquire);
+                    break;
+                default:
+                    if (GetMonitor(word).Enter(thread, markWord_, MarkWord::GetPayload(word))) {
+                        return;
+                    }
+                    word = markWord_.load(std::memory_order_relaxed);
+                    break;
+            }
+        }
+    }
+
+    bool TryLock()
+    {
+        uint32_t thread = LockOwnerId::Current();
+        uint64_t word = markWord_.load(std::memory_order_relaxed);
+        while (true) {
+            switch (MarkWord::GetLockState(word)) {
+                case MarkWord::LockState::UNLOCKED:
+                    if (MarkWord::GetPayload(word) != 0) {
+                        Inflate(word);
+                        word = markWord_.load(std::memory_order_acquire);
+                        break;
+                    }
+                    if (markWord_.compare_exchange_weak(word, ThinLocked(word, thread, 0),
+                                                        std::memory_order_acquire)) {
+                        return true;
+                    }
+                    break;
+                case MarkWord::LockState::THIN:
+                    if (MarkWord::GetThinOwner(word) != thread) {
+                        return false;
+                    }
+                    // recursive lock is always taken
+                    Lock();
+                    return true;
+                default: {
+                    auto result = GetMonitor(word).TryEnter(thread, markWord_, MarkWord::GetPayload(word));
+                    if (result != Monitor::EnterResult::DEFLATED) {
+                        return result == Monitor::EnterResult::ENTERED;
+                    }
+                    word = markWord_.load(std::memory_order_relaxed);
+                    break;
+                }
+            }
+        }
+    }
+
+    void Unlock()
+    {
+        uint32_t thread = LockOwnerId::Current();
+        uint64_t word = markWord_.load(std::memory_order_relaxed);
+        while (true) {
+            if (MarkWord::GetLockState(word) == MarkWord::LockState::INFLATED) {
+                // the owner of the monitor is the only thread which deflates it, so the index is still bound
+                uint32_t index = MarkWord::GetPayload(word);
+                if (GetMonitor(word).Exit(thread, markWord_)) {
+                    MonitorTable::Get().Free(index);
+                }
+                return;
+            }
+            assert(MarkWord::GetLockState(word) == MarkWord::LockState::THIN);
+            assert(MarkWord::GetThinOwner(word) == thread);
+            uint32_t recursion = MarkWord::GetThinRecursion(word);
+            uint64_t unlocked = recursion > 0 ? ThinLocked(word, thread, recursion - 1U)
+                                              : MarkWord::SetLock(word, MarkWord::LockState::UNLOCKED, 0);
+            if (markWord_.compare_exchange_weak(word, unlocked, std::memory_order_release,
+                                                std::memory_order_relaxed)) {
+                return;
+            }
+        }
+    }
+
+    const TypeDescriptor &GetType() const
+    {
+        return TypeRegistry::Get(typeId_);
+    }
+
+    uint32_t GetTypeId() const
+    {
+        return typeId_;
+    }
+
+    uint64_t GetMarkWord() const
+    {
+        return markWord_.load(std::memory_order_relaxed);
+    }
+
+    /// @returns true if the object was not marked before
+    bool Mark()
+    {
+        return (markWord_.fetch_or(MarkWord::MARK_BIT, std::memory_order_relaxed) & MarkWord::MARK_BIT) == 0;
+    }
+
+    void ClearMark()
+    {
+        markWord_.fetch_and(~MarkWord::MARK_BIT, std::memory_order_relaxed);
+    }
+
+    bool IsMarked() const
+    {
+        return (markWord_.load(std::memory_order_relaxed) & MarkWord::MARK_BIT) != 0;
+    }
+
+    /**
+     * @brief Destroys the value and the header, memory is freed by the caller
+     * @returns size of the object memory
+     */
+    size_t Finalize()
+    {
+        uint64_t word = markWord_.load(std::memory_order_relaxed);
+        if (MarkWord::GetLockState(word) == MarkWord::LockState::INFLATED) {
+            MonitorTable::Get().Free(MarkWord::GetPayload(word));
+        }
+        const TypeDescriptor &type = GetType();
+        type.destroy(GetValue());
+        this->~ObjectHeader();
+        return sizeof(ObjectHeader) + type.size;
+    }
+
+    /// @brief Destroys the value and frees memory of the object
+    void Destroy()
+    {
+        size_t size = Finalize();
+        ObjectHeap::Free(this, size);
+    }
+
+private:
+    static constexpr size_t SPINS_BEFORE_INFLATION = 64U;
+
+    static uint64_t ThinLocked(uint64_t word, uint32_t thread, uint32_t recursion)
+    {
+        return MarkWord::SetLock(word, MarkWord::LockState::THIN, MarkWord::MakeThinPayload(thread, recursion));
+    }
+
+    static Monitor &GetMonitor(uint64_t word)
+    {
+        return MonitorTable::Get().GetMonitor(MarkWord::GetPayload(word));
+    }
+
+    /// @brief Replaces thin lock or identity hash in @param word by a monitor which takes them over
+    void Inflate(uint64_t word)
+    {
+        MonitorTable &table = MonitorTable::Get();
+        uint32_t index = table.Allocate();
+        if (MarkWord::GetLockState(word) == MarkWord::LockState::THIN) {
+            table.GetMonitor(index).Init(MarkWord::GetThinOwner(word), MarkWord::GetThinRecursion(word) + 1U, 0);
+        } else {
+            table.GetMonitor(index).Init(0, 0, MarkWord::GetPayload(word));
+        }
+        uint64_t inflated = MarkWord::SetLock(word, MarkWord::LockState::INFLATED, index);
+        // word could be changed by the owner or by count update, then the caller retries
+        if (!markWord_.compare_exchange_strong(word, inflated, std::memory_order_acq_rel)) {
+            table.Free(index);
+        }
+    }
+
+    static uint32_t GenerateHash()
+    {
+        // Marsaglia xor-shift, state is per thread so hashing does not contend
+        thread_local uint32_t state = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&state));  // NOLINT
+        state ^= state << 13U;
+        state ^= state >> 17U;
+        state ^= state << 5U;
+        return (state & ((uint32_t(1) << MarkWord::PAYLOAD_BITS) - 1U)) | 1U;
+    }
+
+    std::atomic<uint64_t> markWord_ {MarkWord::REF_COUNT_ONE};
+    uint32_t typeId_;
+};
+
+static_assert(sizeof(ObjectHeader) == 16U);
+
+/**
+ * Reference to the object, it is a single pointer to the value or its compressed offset in the heap, and the header is
+ * found right before the value
+ */
 template <class T>
 class Object {
 public:
     Object() = default;
     explicit Object(std::nullptr_t) {}
 
-    ~Object() = default;  // this method should be changed
+    ~Object()
+    {
+        if (ref_ != Reference {}) {
+            ObjectHeader *header = ObjectHeader::FromValue(Get());
+            ref_ = Reference {};
+            if (header->DecRef()) {
+                header->Destroy();
+            }
+        }
+    }
 
     // copy semantic
-    Object([[maybe_unused]] const Object<T> &other) {}
+    Object(const Object<T> &other) : ref_(other.ref_)
+    {
+        if (ref_ != Reference {}) {
+            ObjectHeader::FromValue(Get())->IncRef();
+        }
+    }
     // NOLINTNEXTLINE(bugprone-unhandled-self-assignment)
-    Object<T> &operator=([[maybe_unused]] const Object<T> &other)
+    Object<T> &operator=(const Object<T> &other)
     {
+        Object<T>(other).Swap(*this);
         return *this;
     }
 
     // move semantic
-    Object([[maybe_unused]] Object<T> &&other) {}
-    Object<T> &operator=([[maybe_unused]] Object<T> &&other)
+    Object(Object<T> &&other) noexcept : ref_(std::exchange(other.ref_, Reference {})) {}
+    Object<T> &operator=(Object<T> &&other) noexcept
     {
+        Object<T>(std::move(other)).Swap(*this);
         return *this;
     }
 
     // member access operators
     T &operator*() const noexcept
     {
-        return *val_;
+        return *Get();
     }
 
     T *operator->() const noexcept
     {
-        return val_;
+        return Get();
+    }
+
+    T *Get() const
+    {
+        return static_cast<T *>(ObjectHeap::Decompress(ref_));
     }
 
     size_t UseCount() const
     {
-        return 0;
+        return ref_ != Reference {} ? ObjectHeader::FromValue(Get())->GetRefCount() : 0;
+    }
+
+    /// @returns identity hash of the object or 0 for nullptr
+    uint32_t HashCode() const
+    {
+        return ref_ != Reference {} ? ObjectHeader::FromValue(Get())->GetHashCode() : 0;
+    }
+
+    ObjectHeader *GetHeader() const
+    {
+        return ref_ != Reference {} ? ObjectHeader::FromValue(Get()) : nullptr;
+    }
+
+    /// @brief Locks monitor of the object, the lock is recursive
+    void Lock() const
+    {
+        ObjectHeader::FromValue(Get())->Lock();
+    }
+
+    bool TryLock() const
+    {
+        return ObjectHeader::FromValue(Get())->TryLock();
     }
 
-    bool operator==([[maybe_unused]] const Object<T> other) const
+    void Unlock() const
     {
-        return false;
+        ObjectHeader::FromValue(Get())->Unlock();
     }
 
-    bool operator!=(const Object<T> other) const
+    bool operator==(const Object<T> &other) const
+    {
+        return ref_ == other.ref_;
+    }
+
+    bool operator!=(const Object<T> &other) const
     {
         return !(*this == other);
     }
 
     bool operator==(std::nullptr_t) const
     {
-        return false;
+        return ref_ == Reference {};
     }
 
     bool operator!=(std::nullptr_t) const
     {
-        return false;
+        return ref_ != Reference {};
+    }
+
+    void Swap(Object<T> &other) noexcept
+    {
+        std::swap(ref_, other.ref_);
     }
 
 private:
-    // Add your constructor
+    using Reference = ObjectHeap::Reference;
+
+    template <class U, class... Args>
+    friend Object<U> MakeObject(Args &&...args);
 
-    // TODO(you): Add your fields and methods here...
-    T *val_ = nullptr;  // this field can be deleted
+    explicit Object(T *val) : ref_(ObjectHeap::Compress(val)) {}
+
+    Reference ref_ {};
 };
 
-#endif  // MEMORY_MANAGEMENT_REFERECNCE_COUNTING_GC_INCLUDE_OBJECT_MODLE_H
\ No newline at end of file
+/// @brief Allocates header and value of T constructed from @param args in one block
+template <class T, class... Args>
+Object<T> MakeObject(Args &&...args)
+{
+    static_assert(alignof(T) <= alignof(ObjectHeader), "value is aligned by the header size only");
+    void *memory = ObjectHeap::Allocate(sizeof(ObjectHeader) + sizeof(T));
+    auto *header = new (memory) ObjectHeader(TypeRegistry::GetId<T>());
+    try {
+        return Object<T>(new (header->GetValue()) T(std::forward<Args>(args)...));
+    } catch (...) {
+        header->~ObjectHeader();
+        ObjectHeap::Free(memory, sizeof(ObjectHeader) + sizeof(T));
+        throw;
+    }
+}
+
+#endif  // MEMORY_MANAGEMENT_REFERECNCE_COUNTING_GC_INCLUDE_OBJECT_MODLE_H
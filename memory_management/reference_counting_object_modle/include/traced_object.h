@@ -0,0 +1,381 @@
+#ifndef MEMORY_MANAGEMENT_REFERECNCE_COUNTING_OBJECT_MODLE_INCLUDE_TRACED_OBJECT_H
+#define MEMORY_MANAGEMENT_REFERECNCE_COUNTING_OBJECT_MODLE_INCLUDE_TRACED_OBJECT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <vector>
+#include "base/macros.h"
+#include "memory_management/free_list_allocator/include/free_list_allocator.h"
+#include "memory_management/reference_counting_object_modle/include/object_modle.h"
+
+// Tracing backend of the object model: stop-the-world mark-sweep collector. Objects have the same header as reference
+// counted ones, the collector uses its mark bit and does not touch the count. References from the stack
+// (TracedObject) are registered in the list of roots and are the only handles which keep objects alive. References
+// from heap objects (TracedField) are plain pointers without any write cost, the collector finds them by the field
+// map of the type descriptor, so a type lists offsets of its fields in static constexpr GetTracedFields().
+// Cycles are collected. Objects and handles are not thread-safe, every thread has its own heap.
+
+class TracingHeap;
+
+/// Element of the intrusive list of roots, list is used instead of a stack because handles can be moved anywhere
+class TracedRoot {
+public:
+    void *GetValue() const
+    {
+        return value_;
+    }
+
+protected:
+    inline explicit TracedRoot(void *value);
+    inline ~TracedRoot();
+    NO_COPY_SEMANTIC(TracedRoot);
+    NO_MOVE_SEMANTIC(TracedRoot);
+
+    void *value_;  // NOLINT(misc-non-private-member-variables-in-classes)
+
+private:
+    friend class TracingHeap;
+
+    TracedRoot *prev_ {nullptr};
+    TracedRoot *next_ {nullptr};
+};
+
+/// Reference from a heap object, the field map of the owner type contains its offset
+class TracedFieldBase {
+public:
+    void *GetValue() const
+    {
+        return value_;
+    }
+
+protected:
+    TracedFieldBase() = default;
+    explicit TracedFieldBase(void *value) : value_(value) {}
+    ~TracedFieldBase() = default;
+    DEFAULT_COPY_SEMANTIC(TracedFieldBase);
+    DEFAULT_MOVE_SEMANTIC(TracedFieldBase);
+
+    void *value_ {nullptr};  // NOLINT(misc-non-private-member-variables-in-classes)
+};
+
+class TracingHeap {
+public:
+    static constexpr size_t DEFAULT_COLLECTION_THRESHOLD = size_t(8) << 20U;
+    static constexpr size_t POOL_SIZE = size_t(4) << 20U;
+    // larger objects are allocated by operator new
+    static constexpr size_t MAX_POOLED_SIZE = size_t(64) << 10U;
+
+    static TracingHeap &Get()
+    {
+        thread_local TracingHeap heap;
+        return heap;
+    }
+
+    /**
+     * @brief Marks objects which are reachable from roots and frees the others. Raw pointers to objects which are
+     * not reachable become invalid.
+     * @returns count of freed objects
+     */
+    size_t Collect()
+    {
+        if (UNLIKELY(inCollection_ || constructing_ > 0)) {
+            return 0;
+        }
+        inCollection_ = true;
+        for (TracedRoot *root = roots_; root != nullptr; root = root->next_) {
+            MarkValue(root->value_);
+        }
+        while (!markStack_.empty()) {
+            ObjectHeader *header = markStack_.back();
+            markStack_.pop_back();
+            const TypeDescriptor &type = header->GetType();
+            auto *value = static_cast<uint8_t *>(header->GetValue());
+            for (size_t i = 0; i < type.fieldsCount; i++) {
+                // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                auto *field = reinterpret_cast<TracedFieldBase *>(value + type.fields[i]);  // NOLINT(*-reinterpret-cast)
+                MarkValue(field->GetValue());
+            }
+        }
+        size_t kept = 0;
+        // survivors are moved to the front in the allocation order, dead objects are freed after the list is
+        // compacted, so destructors of values can allocate objects
+        for (ObjectHeader *header : objects_) {
+            if (header->IsMarked()) {
+                header->ClearMark();
+                objects_[kept++] = header;  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+            } else {
+                dead_.push_back(header);
+            }
+        }
+        objects_.resize(kept);
+        allocatedSinceCollection_ = 0;
+        size_t freed = dead_.size();
+        for (ObjectHeader *header : dead_) {
+            FreeObject(header);
+        }
+        dead_.clear();
+        inCollection_ = false;
+        return freed;
+    }
+
+    /// @brief Allocation calls Collect if @param threshold bytes were allocated since the last collection
+    void SetCollectionThreshold(size_t threshold)
+    {
+        collectionThreshold_ = threshold;
+    }
+
+    size_t GetObjectsCount() const
+    {
+        return objects_.size();
+    }
+
+    template <class T, class... Args>
+    T *Allocate(Args &&...args)
+    {
+        static_assert(alignof(T) <= alignof(ObjectHeader), "value is aligned by the header size only");
+        constexpr size_t SIZE = sizeof(ObjectHeader) + sizeof(T);
+        if (UNLIKELY(allocatedSinceCollection_ >= collectionThreshold_)) {
+            Collect();
+        }
+        void *memory = AllocateMemory(SIZE);
+        auto *header = new (memory) ObjectHeader(TypeRegistry::GetId<T>());
+        T *value = nullptr;
+        // objects which are allocated by the constructor are referenced only by the value under construction
+        constructing_++;
+        try {
+            value = new (header->GetValue()) T(std::forward<Args>(args)...);
+        } catch (...) {
+            constructing_--;
+            header->~ObjectHeader();
+            FreeMemory(memory, SIZE);
+            throw;
+        }
+        constructing_--;
+        objects_.push_back(header);
+        allocatedSinceCollection_ += SIZE;
+        return value;
+    }
+
+    ~TracingHeap()
+    {
+        // destructors of values can allocate objects, they are freed by the next pass
+        while (!objects_.empty()) {
+            dead_.swap(objects_);
+            for (ObjectHeader *header : dead_) {
+                FreeObject(header);
+            }
+            dead_.clear();
+        }
+    }
+    NO_COPY_SEMANTIC(TracingHeap);
+    NO_MOVE_SEMANTIC(TracingHeap);
+
+private:
+    friend class TracedRoot;
+
+    TracingHeap() = default;
+
+    void LinkRoot(TracedRoot *root)
+    {
+        root->next_ = roots_;
+        if (roots_ != nullptr) {
+            roots_->prev_ = root;
+        }
+        roots_ = root;
+    }
+
+    void UnlinkRoot(TracedRoot *root)
+    {
+        if (root->prev_ != nullptr) {
+            root->prev_->next_ = root->next_;
+        } else {
+            roots_ = root->next_;
+        }
+        if (root->next_ != nullptr) {
+            root->next_->prev_ = root->prev_;
+        }
+    }
+
+    void MarkValue(void *value)
+    {
+        if (value != nullptr) {
+            ObjectHeader *header = ObjectHeader::FromValue(value);
+            if (header->Mark()) {
+                markStack_.push_back(header);
+            }
+        }
+    }
+
+    void *AllocateMemory(size_t size)
+    {
+        void *memory = size <= MAX_POOLED_SIZE ? allocator_.Allocate(size) : ::operator new(size);
+        if (UNLIKELY(memory == nullptr)) {
+            throw std::bad_alloc();
+        }
+        return memory;
+    }
+
+    void FreeMemory(void *memory, size_t size)
+    {
+        if (size <= MAX_POOLED_SIZE) {
+            allocator_.Free(memory);
+        } else {
+            ::operator delete(memory);
+        }
+    }
+
+    void FreeObject(ObjectHeader *header)
+    {
+        size_t size = header->Finalize();
+        FreeMemory(header, size);
+    }
+
+    FreeListAllocator<POOL_SIZE, FreeListPolicy::SEGREGATED_FIT> allocator_;
+    std::vector<ObjectHeader *> objects_;
+    std::vector<ObjectHeader *> markStack_;
+    std::vector<ObjectHeader *> dead_;
+    TracedRoot *roots_ {nullptr};
+    size_t allocatedSinceCollection_ {0};
+    size_t collectionThreshold_ {DEFAULT_COLLECTION_THRESHOLD};
+    size_t constructing_ {0};
+    bool inCollection_ {false};
+};
+
+TracedRoot::TracedRoot(void *value) : value_(value)
+{
+    TracingHeap::Get().LinkRoot(this);
+}
+
+TracedRoot::~TracedRoot()
+{
+    TracingHeap::Get().UnlinkRoot(this);
+}
+
+template <class T>
+class TracedField;
+
+/// Reference from the stack, it keeps the object alive as a root
+template <class T>
+class TracedObject final : public TracedRoot {
+public:
+    TracedObject() : TracedRoot(nullptr) {}
+    explicit TracedObject(std::nullptr_t) : TracedRoot(nullptr) {}
+    explicit TracedObject(T *value) : TracedRoot(value) {}
+    explicit TracedObject(const TracedField<T> &field) : TracedRoot(field.GetValue()) {}
+    ~TracedObject() = default;
+
+    TracedObject(const TracedObject<T> &other) : TracedRoot(other.value_) {}
+    TracedObject<T> &operator=(const TracedObject<T> &other)
+    {
+        value_ = other.value_;
+        return *this;
+    }
+    TracedObject(TracedObject<T> &&other) noexcept : TracedRoot(other.value_) {}
+    TracedObject<T> &operator=(TracedObject<T> &&other) noexcept
+    {
+        value_ = other.value_;
+        return *this;
+    }
+    TracedObject<T> &operator=(const TracedField<T> &field)
+    {
+        value_ = field.GetValue();
+        return *this;
+    }
+    TracedObject<T> &operator=(std::nullptr_t)
+    {
+        value_ = nullptr;
+        return *this;
+    }
+
+    T &operator*() const noexcept
+    {
+        return *Get();
+    }
+
+    T *operator->() const noexcept
+    {
+        return Get();
+    }
+
+    T *Get() const
+    {
+        return static_cast<T *>(value_);
+    }
+
+    ObjectHeader *GetHeader() const
+    {
+        return value_ != nullptr ? ObjectHeader::FromValue(value_) : nullptr;
+    }
+
+    bool operator==(std::nullptr_t) const
+    {
+        return value_ == nullptr;
+    }
+
+    bool operator!=(std::nullptr_t) const
+    {
+        return value_ != nullptr;
+    }
+};
+
+template <class T>
+class TracedField final : public TracedFieldBase {
+public:
+    TracedField() = default;
+    explicit TracedField(std::nullptr_t) {}
+    explicit TracedField(const TracedObject<T> &object) : TracedFieldBase(object.GetValue()) {}
+    ~TracedField() = default;
+    DEFAULT_COPY_SEMANTIC(TracedField);
+    DEFAULT_MOVE_SEMANTIC(TracedField);
+
+    TracedField<T> &operator=(const TracedObject<T> &object)
+    {
+        value_ = object.GetValue();
+        return *this;
+    }
+    TracedField<T> &operator=(std::nullptr_t)
+    {
+        value_ = nullptr;
+        return *this;
+    }
+
+    T &operator*() const noexcept
+    {
+        return *Get();
+    }
+
+    T *operator->() const noexcept
+    {
+        return Get();
+    }
+
+    T *Get() const
+    {
+        return static_cast<T *>(value_);
+    }
+
+    bool operator==(const TracedField<T> &other) const
+    {
+        return value_ == other.value_;
+    }
+
+    bool operator==(std::nullptr_t) const
+    {
+        return value_ == nullptr;
+    }
+
+    bool operator!=(std::nullptr_t) const
+    {
+        return value_ != nullptr;
+    }
+};
+
+template <class T, class... Args>
+TracedObject<T> MakeTracedObject(Args &&...args)
+{
+    return TracedObject<T>(TracingHeap::Get().Allocate<T>(std::forward<Args>(args)...));
+}
+
+#endif  // MEMORY_MANAGEMENT_REFERECNCE_COUNTING_OBJECT_MODLE_INCLUDE_TRACED_OBJECT_H
@@ -1,4 +1,6 @@
 #include <gtest/gtest.h>
+#include <thread>
+#include <vector>
 #include "memory_management/reference_counting_object_modle/include/object_modle.h"
 #include "base/macros.h"
 #include "delete_detector.h"
@@ -13,7 +15,7 @@ public:
     }
 };
 
-TEST(ReferenceCountingOM, DISABLED_SinglePtrUsage)
+TEST(ReferenceCountingOM, SinglePtrUsage)
 {
     Object<size_t> obj;
     ASSERT_EQ(obj.UseCount(), 0);
@@ -31,7 +33,7 @@ TEST(ReferenceCountingOM, DISABLED_SinglePtrUsage)
     ASSERT_EQ(classObj->Get(), Return42().Get());
 }
 
-TEST(ReferenceCountingOM, DISABLED_CopySemanticUsage)
+TEST(ReferenceCountingOM, CopySemanticUsage)
 {
     constexpr size_t VALUE_TO_CREATE = 42U;
     Object<size_t> obj1 = MakeObject<size_t>(VALUE_TO_CREATE);
@@ -50,7 +52,7 @@ TEST(ReferenceCountingOM, DISABLED_CopySemanticUsage)
     ASSERT_EQ(obj1.UseCount(), 1U);
 }
 
-TEST(ReferenceCountingOM, DISABLED_MoveSemanticUsage)
+TEST(ReferenceCountingOM, MoveSemanticUsage)
 {
     constexpr size_t VALUE_TO_CREATE = 42U;
     Object<size_t> obj1 = MakeObject<size_t>(VALUE_TO_CREATE);
@@ -71,7 +73,7 @@ TEST(ReferenceCountingOM, DISABLED_MoveSemanticUsage)
     ASSERT_EQ(obj1.UseCount(), 1U);
 }
 
-TEST(ReferenceCountingOM, DISABLED_GcDeletingTest)
+TEST(ReferenceCountingOM, GcDeletingTest)
 {
     DeleteDetector::SetDeleteCount(0U);
     auto obj1 = MakeObject<DeleteDetector>();
@@ -88,7 +90,7 @@ TEST(ReferenceCountingOM, DISABLED_GcDeletingTest)
     ASSERT_EQ(DeleteDetector::GetDeleteCount(), 3U);
 }
 
-TEST(ReferenceCountingOM, DISABLED_Etest)
+TEST(ReferenceCountingOM, Etest)
 {
     constexpr size_t VALUE_TO_CREATE = 42U;
     auto obj1 = MakeObject<size_t>(VALUE_TO_CREATE);
@@ -97,3 +99,212 @@ TEST(ReferenceCountingOM, DISABLED_Etest)
     ASSERT_NE(obj1, obj2);
     ASSERT_EQ(*obj1, *obj2);
 }
+
+TEST(ReferenceCountingOM, ObjectHeaderTest)
+{
+    static_assert(sizeof(Object<size_t>) == sizeof(ObjectHeap::Reference));
+    static_assert(sizeof(ObjectHeader) == 16U);
+    constexpr size_t VALUE_TO_CREATE = 42U;
+    auto obj = MakeObject<size_t>(VALUE_TO_CREATE);
+    ObjectHeader *header = obj.GetHeader();
+    // header is placed right before the value
+    ASSERT_EQ(header->GetValue(), &*obj);
+    ASSERT_EQ(header->GetType().size, sizeof(size_t));
+    ASSERT_EQ(header->GetTypeId(), TypeRegistry::GetId<size_t>());
+    ASSERT_NE(header->GetTypeId(), TypeRegistry::GetId<Return42>());
+
+    // count is kept in the mark word
+    auto copy = obj;
+    ASSERT_EQ(MarkWord::GetRefCount(header->GetMarkWord()), 2U);
+    ASSERT_EQ(MarkWord::GetLockState(header->GetMarkWord()), MarkWord::LockState::UNLOCKED);
+
+    uint32_t hash = obj.HashCode();
+    ASSERT_NE(hash, 0U);
+    ASSERT_EQ(copy.HashCode(), hash);
+    ASSERT_EQ(MarkWord::GetPayload(header->GetMarkWord()), hash);
+    // hashing does not change the count
+    ASSERT_EQ(obj.UseCount(), 2U);
+    ASSERT_EQ(Object<size_t>().HashCode(), 0U);
+}
+
+TEST(ReferenceCountingOM, ThinLockTest)
+{
+    auto obj = MakeObject<size_t>(0U);
+    ObjectHeader *header = obj.GetHeader();
+    obj.Lock();
+    ASSERT_EQ(MarkWord::GetLockState(header->GetMarkWord()), MarkWord::LockState::THIN);
+    ASSERT_EQ(MarkWord::GetThinOwner(header->GetMarkWord()), LockOwnerId::Current());
+    // lock is recursive
+    ASSERT_TRUE(obj.TryLock());
+    ASSERT_EQ(MarkWord::GetThinRecursion(header->GetMarkWord()), 1U);
+    // lock bits do not change the count
+    auto copy = obj;
+    ASSERT_EQ(obj.UseCount(), 2U);
+    obj.Unlock();
+    ASSERT_EQ(MarkWord::GetLockState(header->GetMarkWord()), MarkWord::LockState::THIN);
+    obj.Unlock();
+    ASSERT_EQ(MarkWord::GetLockState(header->GetMarkWord()), MarkWord::LockState::UNLOCKED);
+    ASSERT_EQ(MarkWord::GetPayload(header->GetMarkWord()), 0U);
+    ASSERT_EQ(obj.UseCount(), 2U);
+
+    // thin lock is taken by another thread
+    obj.Lock();
+    bool locked = true;
+    std::thread([&locked, &obj]() { locked = obj.TryLock(); }).join();
+    ASSERT_FALSE(locked);
+    obj.Unlock();
+}
+
+TEST(ReferenceCountingOM, LockHashTest)
+{
+    auto obj = MakeObject<size_t>(0U);
+    ObjectHeader *header = obj.GetHeader();
+    // hash of the locked object moves to the monitor
+    obj.Lock();
+    uint32_t hash = obj.HashCode();
+    ASSERT_NE(hash, 0U);
+    ASSERT_EQ(MarkWord::GetLockState(header->GetMarkWord()), MarkWord::LockState::INFLATED);
+    obj.Unlock();
+    // released monitor is deflated, the hash moves back to the mark word
+    ASSERT_EQ(MarkWord::GetLockState(header->GetMarkWord()), MarkWord::LockState::UNLOCKED);
+    ASSERT_EQ(MarkWord::GetPayload(header->GetMarkWord()), hash);
+    ASSERT_EQ(obj.HashCode(), hash);
+
+    // locking of the hashed object keeps the hash
+    auto hashed = MakeObject<size_t>(0U);
+    uint32_t otherHash = hashed.HashCode();
+    hashed.Lock();
+    ASSERT_EQ(MarkWord::GetLockState(hashed.GetHeader()->GetMarkWord()), MarkWord::LockState::INFLATED);
+    ASSERT_EQ(hashed.HashCode(), otherHash);
+    ASSERT_TRUE(hashed.TryLock());
+    hashed.Unlock();
+    hashed.Unlock();
+    ASSERT_EQ(MarkWord::GetLockState(hashed.GetHeader()->GetMarkWord()), MarkWord::LockState::UNLOCKED);
+    ASSERT_EQ(MarkWord::GetPayload(hashed.GetHeader()->GetMarkWord()), otherHash);
+    ASSERT_EQ(hashed.HashCode(), otherHash);
+
+    // monitors of hashed objects are reused, so live hashed objects do not exhaust the table
+    constexpr size_t OBJECTS_COUNT = 4U * MonitorTable::CHUNK_SIZE;
+    std::vector<Object<size_t>> objects;
+    for (size_t i = 0; i < OBJECTS_COUNT; i++) {
+        objects.push_back(MakeObject<size_t>(i));
+        objects.back().HashCode();
+        objects.back().Lock();
+        objects.back().Unlock();
+        ASSERT_EQ(MarkWord::GetLockState(objects.back().GetHeader()->GetMarkWord()), MarkWord::LockState::UNLOCKED);
+    }
+}
+
+TEST(ReferenceCountingOM, MonitorDeflationTest)
+{
+    auto obj = MakeObject<size_t>(0U);
+    ObjectHeader *header = obj.GetHeader();
+    obj.Lock();
+    std::thread waiter([obj]() {
+        obj.Lock();
+        (*obj)++;
+        obj.Unlock();
+    });
+    // the waiter inflates the contended lock
+    while (MarkWord::GetLockState(header->GetMarkWord()) != MarkWord::LockState::INFLATED) {
+        std::this_thread::yield();
+    }
+    obj.Unlock();
+    waiter.join();
+    ASSERT_EQ(*obj, 1U);
+    // the last exit without waiters and hash returns the object to the thin lock
+    ASSERT_EQ(MarkWord::GetLockState(header->GetMarkWord()), MarkWord::LockState::UNLOCKED);
+    ASSERT_EQ(MarkWord::GetPayload(header->GetMarkWord()), 0U);
+    ASSERT_EQ(obj.UseCount(), 1U);
+    obj.Lock();
+    ASSERT_EQ(MarkWord::GetLockState(header->GetMarkWord()), MarkWord::LockState::THIN);
+    obj.Unlock();
+}
+
+TEST(ReferenceCountingOM, ContendedLockTest)
+{
+    constexpr size_t THREADS_COUNT = 4U;
+    constexpr size_t INCREMENTS_COUNT = 10000U;
+    auto obj = MakeObject<size_t>(0U);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < THREADS_COUNT; i++) {
+        threads.emplace_back([obj]() {
+            for (size_t j = 0; j < INCREMENTS_COUNT; j++) {
+                obj.Lock();
+                (*obj)++;
+                obj.Unlock();
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(*obj, THREADS_COUNT * INCREMENTS_COUNT);
+    ASSERT_EQ(obj.UseCount(), 1U);
+    ASSERT_EQ(MarkWord::GetLockState(obj.GetHeader()->GetMarkWord()), MarkWord::LockState::UNLOCKED);
+}
+
+#ifdef PROJECT_ENABLE_COMPRESSED_REFERENCES
+TEST(ReferenceCountingOM, CompressedReferenceTest)
+{
+    struct Node {
+        Object<Node> left;
+        Object<Node> right;
+    };
+    static_assert(sizeof(Object<Node>) == sizeof(uint32_t));
+    static_assert(sizeof(Node) == 2U * sizeof(uint32_t));
+
+    auto root = MakeObject<Node>();
+    root->left = MakeObject<Node>();
+    root->right = root->left;
+    ASSERT_EQ(root->left, root->right);
+    ASSERT_EQ(root->left.UseCount(), 2U);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(root.GetHeader()) % ObjectHeap::ALIGNMENT, 0U);  // NOLINT
+    ASSERT_EQ(root->left->left, nullptr);
+
+    // freed block is reused by the object of the same size
+    size_t used = ObjectHeap::GetUsedSize();
+    Node *freed = root->left.Get();
+    root->left = Object<Node>();
+    root->right = Object<Node>();
+    root->left = MakeObject<Node>();
+    ASSERT_EQ(root->left.Get(), freed);
+    ASSERT_EQ(ObjectHeap::GetUsedSize(), used);
+
+    // large objects are reused as well
+    using Large = std::array<size_t, 1024U>;
+    auto large = MakeObject<Large>();
+    Large *freedLarge = large.Get();
+    large = MakeObject<Large>();
+    large = MakeObject<Large>();
+    ASSERT_EQ(large.Get(), freedLarge);
+}
+
+TEST(ReferenceCountingOM, CompressedHeapSplitTest)
+{
+    using Large = std::array<size_t, 1024U>;
+    using Huge = std::array<size_t, 4U * 1024U>;
+    size_t used = ObjectHeap::GetUsedSize();
+
+    // the last block returns to the bump pointer
+    auto huge = MakeObject<Huge>();
+    ASSERT_GT(ObjectHeap::GetUsedSize(), used);
+    huge = Object<Huge>();
+    ASSERT_EQ(ObjectHeap::GetUsedSize(), used);
+
+    // the freed block is split between smaller objects
+    huge = MakeObject<Huge>();
+    auto guard = MakeObject<Huge>();
+    used = ObjectHeap::GetUsedSize();
+    auto *freedHuge = reinterpret_cast<uint8_t *>(huge.Get());  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    huge = Object<Huge>();
+    auto first = MakeObject<Large>();
+    auto second = MakeObject<Large>();
+    auto third = MakeObject<Large>();
+    ASSERT_EQ(reinterpret_cast<uint8_t *>(first.Get()), freedHuge);  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    ASSERT_EQ(ObjectHeap::GetUsedSize(), used);
+    // the range is made writable by chunks ahead of the bump pointer
+    ASSERT_GE(ObjectHeap::GetCommittedSize(), used);
+    ASSERT_EQ(ObjectHeap::GetCommittedSize() % (size_t(1) << 20U), 0U);
+}
+#endif
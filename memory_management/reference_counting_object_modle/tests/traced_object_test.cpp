@@ -0,0 +1,201 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cstddef>
+#include "memory_management/reference_counting_object_modle/include/traced_object.h"
+#include "base/macros.h"
+
+namespace {
+
+class TracedNode {
+public:
+    TracedNode() : id(count_++) {}
+    ~TracedNode()
+    {
+        count_--;
+    }
+    NO_COPY_SEMANTIC(TracedNode);
+    NO_MOVE_SEMANTIC(TracedNode);
+
+    static constexpr std::array<size_t, 2U> GetTracedFields()
+    {
+        return {MEMBER_OFFSET(TracedNode, left), MEMBER_OFFSET(TracedNode, right)};
+    }
+
+    static size_t GetCount()
+    {
+        return count_;
+    }
+
+    // offsetof needs the standard layout, so all fields are public
+    TracedField<TracedNode> left;   // NOLINT(misc-non-private-member-variables-in-classes)
+    TracedField<TracedNode> right;  // NOLINT(misc-non-private-member-variables-in-classes)
+    const size_t id;                // NOLINT(misc-non-private-member-variables-in-classes)
+
+private:
+    static inline size_t count_ = 0;
+};
+
+/// Builds the whole tree in the constructor, so children are allocated while the parent is not in the heap yet
+class TracedTree {
+public:
+    explicit TracedTree(size_t depth)
+    {
+        root = Build(depth);
+    }
+
+    static constexpr std::array<size_t, 1U> GetTracedFields()
+    {
+        return {MEMBER_OFFSET(TracedTree, root)};
+    }
+
+    TracedField<TracedNode> root;  // NOLINT(misc-non-private-member-variables-in-classes)
+
+private:
+    static TracedObject<TracedNode> Build(size_t depth)
+    {
+        auto node = MakeTracedObject<TracedNode>();
+        if (depth > 0) {
+            node->left = Build(depth - 1U);
+            node->right = Build(depth - 1U);
+        }
+        return node;
+    }
+};
+
+/// Allocates an object when it is destroyed, so the allocation happens during the sweep
+class AllocatingOnDelete {
+public:
+    AllocatingOnDelete() = default;
+    ~AllocatingOnDelete()
+    {
+        MakeTracedObject<TracedNode>();
+    }
+    NO_COPY_SEMANTIC(AllocatingOnDelete);
+    NO_MOVE_SEMANTIC(AllocatingOnDelete);
+};
+
+}  // namespace
+
+TEST(TracingGC, RootsTest)
+{
+    TracingHeap &heap = TracingHeap::Get();
+    heap.Collect();
+    size_t objects = heap.GetObjectsCount();
+    {
+        auto root = MakeTracedObject<TracedNode>();
+        MakeTracedObject<TracedNode>();
+        ASSERT_EQ(heap.GetObjectsCount(), objects + 2U);
+        ASSERT_EQ(heap.Collect(), 1U);
+        ASSERT_EQ(root->id + 1U, TracedNode::GetCount());
+
+        // value types without fields are supported too
+        auto value = MakeTracedObject<size_t>(42U);
+        auto copy = value;
+        value = nullptr;
+        ASSERT_EQ(heap.Collect(), 0U);
+        ASSERT_EQ(*copy, 42U);
+    }
+    ASSERT_EQ(heap.Collect(), 2U);
+    ASSERT_EQ(heap.GetObjectsCount(), objects);
+}
+
+TEST(TracingGC, FieldsTest)
+{
+    TracingHeap &heap = TracingHeap::Get();
+    heap.Collect();
+    size_t nodes = TracedNode::GetCount();
+    {
+        auto root = MakeTracedObject<TracedNode>();
+        root->left = MakeTracedObject<TracedNode>();
+        root->left->right = MakeTracedObject<TracedNode>();
+        // fields are traced through the field map of the type descriptor
+        ASSERT_EQ(TypeRegistry::Get(root.GetHeader()->GetTypeId()).fieldsCount, 2U);
+        ASSERT_EQ(heap.Collect(), 0U);
+        ASSERT_EQ(TracedNode::GetCount(), nodes + 3U);
+
+        TracedObject<TracedNode> middle(root->left);
+        root->left = nullptr;
+        ASSERT_EQ(heap.Collect(), 0U);
+        middle = nullptr;
+        ASSERT_EQ(heap.Collect(), 2U);
+        ASSERT_EQ(TracedNode::GetCount(), nodes + 1U);
+        ASSERT_FALSE(root.GetHeader()->IsMarked());
+    }
+    heap.Collect();
+    ASSERT_EQ(TracedNode::GetCount(), nodes);
+}
+
+TEST(TracingGC, CycleTest)
+{
+    TracingHeap &heap = TracingHeap::Get();
+    heap.Collect();
+    size_t nodes = TracedNode::GetCount();
+    {
+        auto first = MakeTracedObject<TracedNode>();
+        auto second = MakeTracedObject<TracedNode>();
+        first->left = second;
+        second->left = first;
+        first->right = first;
+        ASSERT_EQ(heap.Collect(), 0U);
+    }
+    ASSERT_EQ(heap.Collect(), 2U);
+    ASSERT_EQ(TracedNode::GetCount(), nodes);
+}
+
+TEST(TracingGC, AutomaticCollectionTest)
+{
+    constexpr size_t DEPTH = 6U;
+    constexpr size_t TREE_SIZE = (size_t(1) << (DEPTH + 1U)) - 1U;
+    constexpr size_t TREES_COUNT = 100U;
+    TracingHeap &heap = TracingHeap::Get();
+    heap.Collect();
+    size_t nodes = TracedNode::GetCount();
+    heap.SetCollectionThreshold(TREE_SIZE * (sizeof(ObjectHeader) + sizeof(TracedNode)));
+    {
+        auto lived = MakeTracedObject<TracedTree>(DEPTH);
+        for (size_t i = 0; i < TREES_COUNT; i++) {
+            MakeTracedObject<TracedTree>(DEPTH);
+        }
+        // collections during construction of the trees keep the objects which are not in the heap yet
+        ASSERT_LE(TracedNode::GetCount(), nodes + 3U * TREE_SIZE);
+        heap.Collect();
+        ASSERT_EQ(TracedNode::GetCount(), nodes + TREE_SIZE);
+        ASSERT_EQ(lived->root->left->left->right->left->left->right->left, nullptr);
+    }
+    heap.SetCollectionThreshold(TracingHeap::DEFAULT_COLLECTION_THRESHOLD);
+    heap.Collect();
+    ASSERT_EQ(TracedNode::GetCount(), nodes);
+}
+
+TEST(TracingGC, LargeObjectTest)
+{
+    using Large = std::array<size_t, TracingHeap::MAX_POOLED_SIZE / sizeof(size_t)>;
+    TracingHeap &heap = TracingHeap::Get();
+    heap.Collect();
+    {
+        auto large = MakeTracedObject<Large>();
+        (*large)[0] = 1U;
+        MakeTracedObject<Large>();
+        ASSERT_EQ(heap.Collect(), 1U);
+        ASSERT_EQ((*large)[0], 1U);
+    }
+    ASSERT_EQ(heap.Collect(), 1U);
+}
+
+TEST(TracingGC, AllocationInDestructorTest)
+{
+    constexpr size_t OBJECTS_COUNT = 100U;
+    TracingHeap &heap = TracingHeap::Get();
+    heap.Collect();
+    size_t nodes = TracedNode::GetCount();
+    size_t objects = heap.GetObjectsCount();
+    for (size_t i = 0; i < OBJECTS_COUNT; i++) {
+        MakeTracedObject<AllocatingOnDelete>();
+    }
+    ASSERT_EQ(heap.Collect(), OBJECTS_COUNT);
+    // objects allocated by the destructors are kept in the heap and freed by the next collection
+    ASSERT_EQ(TracedNode::GetCount(), nodes + OBJECTS_COUNT);
+    ASSERT_EQ(heap.GetObjectsCount(), objects + OBJECTS_COUNT);
+    ASSERT_EQ(heap.Collect(), OBJECTS_COUNT);
+    ASSERT_EQ(TracedNode::GetCount(), nodes);
+}
@@ -1,49 +1,595 @@
 #ifndef MEMORY_MANAGEMENT_RUN_OF_SLOTS_ALLOCATOR_INCLUDE_RUN_OF_SLOTS_ALLOCATOR_H
 #define MEMORY_MANAGEMENT_RUN_OF_SLOTS_ALLOCATOR_INCLUDE_RUN_OF_SLOTS_ALLOCATOR_H
 
+#include <sys/mman.h>
+#include <algorithm>
+#include <array>
 #include <cstdint>
 #include <cstddef>
+#include <mutex>
+#include <new>
 #include "base/macros.h"
+#include "memory_management/common/include/allocation_recorder.h"
+#include "memory_management/common/include/allocator_stats.h"
 
 template <size_t ONE_MEM_POOL_SIZE, size_t... SLOTS_SIZES>
 class RunOfSlotsAllocator {
     static_assert(sizeof...(SLOTS_SIZES) != 0, "you should set slots sizes");
+    static_assert(((SLOTS_SIZES != 0) && ...), "slot size can not be 0");
 
-    // here we recommend you to use class MemoryPool to create RunOfSlots for 1 size. Use new to allocate them from
-    // heap. remember, you can not use any containers with heap allocations
+    static constexpr size_t SIZE_CLASSES_COUNT = sizeof...(SLOTS_SIZES);
+    static constexpr std::array<size_t, SIZE_CLASSES_COUNT> SLOT_SIZES = {SLOTS_SIZES...};
+    static_assert(SIZE_CLASSES_COUNT < UINT8_MAX, "too many size classes");
+
+    /// @returns index of the smallest slot size which is not less than @param size or SIZE_CLASSES_COUNT
+    static constexpr size_t FindSizeClassBySize(size_t size)
+    {
+        size_t sizeClass = SIZE_CLASSES_COUNT;
+        for (size_t i = 0; i < SIZE_CLASSES_COUNT; i++) {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+            if (SLOT_SIZES[i] >= size && (sizeClass == SIZE_CLASSES_COUNT || SLOT_SIZES[i] < SLOT_SIZES[sizeClass])) {
+                sizeClass = i;
+            }
+        }
+        return sizeClass;
+    }
+
+    static constexpr size_t MIN_SLOT_SIZE = std::min({SLOTS_SIZES...});
+    static constexpr size_t MAX_SLOT_SIZE = std::max({SLOTS_SIZES...});
+    // sizes above the limit are rare, they are resolved by scan to keep the table small
+    static constexpr size_t SIZE_CLASS_TABLE_LIMIT = 1024U;
+    static constexpr size_t SIZE_CLASS_TABLE_SIZE = std::min(MAX_SLOT_SIZE, SIZE_CLASS_TABLE_LIMIT) + 1U;
+
+    static constexpr std::array<uint8_t, SIZE_CLASS_TABLE_SIZE> MakeSizeClassTable()
+    {
+        std::array<uint8_t, SIZE_CLASS_TABLE_SIZE> table {};
+        for (size_t size = 0; size < SIZE_CLASS_TABLE_SIZE; size++) {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+            table[size] = static_cast<uint8_t>(FindSizeClassBySize(size));
+        }
+        return table;
+    }
+
+    // maps requested size to the index of size class
+    static constexpr std::array<uint8_t, SIZE_CLASS_TABLE_SIZE> SIZE_CLASS_TABLE = MakeSizeClassTable();
+
+    // Run of slots of one size class. Runs are mapped from OS separately and are aligned by their size, so run
+    // of any slot is found by address.
     template <size_t MEM_POOL_SIZE>
     class RunOfSlotsMemoryPool;
+    using Run = RunOfSlotsMemoryPool<ONE_MEM_POOL_SIZE>;
 
 public:
-    RunOfSlotsAllocator() = default;
-    ~RunOfSlotsAllocator() = default;
+    class ThreadCache;
+
+    /// Describes how many runs size class can have and how many empty runs it keeps instead of unmapping them
+    struct RetentionPolicy {
+        size_t maxRunsPerClass = 1U;
+        size_t spareRunsPerClass = 1U;
+    };
+
+    RunOfSlotsAllocator() : RunOfSlotsAllocator(RetentionPolicy {}) {}
+    explicit RunOfSlotsAllocator(RetentionPolicy policy) : policy_(policy) {}
+    ~RunOfSlotsAllocator()
+    {
+        for (auto &sizeClass : sizeClasses_) {
+            while (sizeClass.runs != nullptr) {
+                Run *next = sizeClass.runs->next;
+                Run::Destroy(sizeClass.runs);
+                sizeClass.runs = next;
+            }
+        }
+    }
     NO_MOVE_SEMANTIC(RunOfSlotsAllocator);
     NO_COPY_SEMANTIC(RunOfSlotsAllocator);
 
+    /**
+     * @brief Allocates one slot of the smallest size class which can hold T. Method is thread-safe,
+     * use ThreadCache to avoid contention on the shared runs.
+     * @returns pointer to allocated slot or nullptr if there is no free slot of suitable size
+     */
     template <class T = uint8_t>
     T *Allocate()
     {
-        // TODO(you): Add your implementation here...
-        return nullptr;
+        constexpr size_t SIZE_CLASS = GetSizeClass(sizeof(T));
+        if constexpr (SIZE_CLASS == SIZE_CLASSES_COUNT) {
+            counters_.OnAllocate(false);
+            return nullptr;
+        } else {
+            void *slot = nullptr;
+            counters_.OnAllocate(AllocateSlots(SIZE_CLASS, &slot, 1U) != 0);
+            TraceAllocate(slot, sizeof(T), SIZE_CLASS);
+            return static_cast<T *>(slot);
+        }
+    }
+
+    /**
+     * @brief Allocates one slot for object of @param size bytes, size class is taken from precomputed table
+     * @returns pointer to allocated slot or nullptr if there is no free slot of suitable size
+     */
+    void *Allocate(size_t size)
+    {
+        size_t sizeClass = GetSizeClass(size);
+        void *slot = nullptr;
+        if (sizeClass != SIZE_CLASSES_COUNT) {
+            AllocateSlots(sizeClass, &slot, 1U);
+        }
+        counters_.OnAllocate(slot != nullptr);
+        TraceAllocate(slot, size, sizeClass);
+        return slot;
     }
 
-    void Free([[maybe_unused]] void *ptr)
+    /**
+     * @brief Returns slot to its run. Run which becomes empty is unmapped if size class already keeps enough spare
+     * runs. @param ptr should be allocated by this allocator.
+     */
+    void Free(void *ptr)
     {
-        // TODO(you): Add your implementation here...
+        if (ptr == nullptr) {
+            return;
+        }
+        TraceFree(ptr);
+        FreeSlots(Run::FromPtr(ptr)->GetSizeClass(), &ptr, 1U);
+        counters_.OnFree();
     }
 
     /**
      * @brief Method should check in @param ptr is pointer to mem from this allocator
      * @returns true if ptr is from this allocator
      */
-    bool VerifyPtr([[maybe_unused]] void *ptr)  // TODO(you): remove [[maybe_unused]]
+    bool VerifyPtr(void *ptr)
     {
-        // TODO(you): Add your implementation here...
+        for (auto &sizeClass : sizeClasses_) {
+            std::lock_guard lock(sizeClass.lock);
+            for (Run *run = sizeClass.runs; run != nullptr; run = run->next) {
+                if (run->Contains(ptr)) {
+                    return run->VerifyPtr(ptr);
+                }
+            }
+        }
         return false;
     }
 
+    /// @brief Unmaps all empty runs including the spare ones
+    void ReleaseEmptyRuns()
+    {
+        for (auto &sizeClass : sizeClasses_) {
+            std::lock_guard lock(sizeClass.lock);
+            ReleaseEmptyRunsUnlocked(sizeClass, 0);
+        }
+    }
+
+    /// @returns count of runs which are mapped now
+    size_t GetRunsCount()
+    {
+        size_t count = 0;
+        for (auto &sizeClass : sizeClasses_) {
+            std::lock_guard lock(sizeClass.lock);
+            count += sizeClass.runsCount;
+        }
+        return count;
+    }
+
+    /**
+     * @returns snapshot of the runs occupancy. Every free slot is a free block, slots kept in thread caches are
+     * accounted as used. Operations of a ThreadCache are counted when it exchanges slots with the runs.
+     */
+    AllocatorStats GetStats()
+    {
+        AllocatorStats stats;
+        for (size_t i = 0; i < SIZE_CLASSES_COUNT; i++) {
+            auto &sizeClass = sizeClasses_[i];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+            SizeClassStats classStats;
+            classStats.slotSize = SLOT_SIZES[i];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+            std::lock_guard lock(sizeClass.lock);
+            for (Run *run = sizeClass.runs; run != nullptr; run = run->next) {
+                classStats.runsCount++;
+                classStats.slotsCount += run->GetSlotsCount();
+                classStats.freeSlotsCount += run->GetFreeSlotsCount();
+                stats.AddFreeBlock(classStats.slotSize, run->GetFreeSlotsCount());
+            }
+            stats.bytesReserved += classStats.runsCount * Run::GetMapSize();
+            stats.bytesUsed += (classStats.slotsCount - classStats.freeSlotsCount) * classStats.slotSize;
+            stats.sizeClasses.push_back(classStats);
+        }
+        counters_.Fill(&stats);
+        return stats;
+    }
+
 private:
-    // TODO(you): Add your fields and methods here...
+    struct SizeClassRuns {
+        std::mutex lock;
+        Run *runs {nullptr};
+        size_t runsCount {0};
+        size_t emptyRunsCount {0};
+    };
+
+    static constexpr size_t GetSizeClass(size_t size)
+    {
+        if (LIKELY(size < SIZE_CLASS_TABLE_SIZE)) {
+            return SIZE_CLASS_TABLE[size];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+        }
+        return FindSizeClassBySize(size);
+    }
+
+    /**
+     * @brief Takes up to @param count slots of the size class under one lock, maps new runs if policy allows it
+     * @returns count of slots written to @param slots
+     */
+    size_t AllocateSlots(size_t sizeClassIdx, void **slots, size_t count)
+    {
+        auto &sizeClass = sizeClasses_[sizeClassIdx];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+        std::lock_guard lock(sizeClass.lock);
+        size_t allocated = 0;
+        for (Run *run = sizeClass.runs; run != nullptr && allocated < count; run = run->next) {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            allocated += AllocateFromRun(sizeClass, run, slots + allocated, count - allocated);
+        }
+        while (allocated < count && sizeClass.runsCount < policy_.maxRunsPerClass) {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+            Run *run = Run::Create(SLOT_SIZES[sizeClassIdx], sizeClassIdx);
+            if (run == nullptr) {
+                break;
+            }
+            run->next = sizeClass.runs;
+            sizeClass.runs = run;
+            sizeClass.runsCount++;
+            sizeClass.emptyRunsCount++;
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            allocated += AllocateFromRun(sizeClass, run, slots + allocated, count - allocated);
+        }
+        return allocated;
+    }
+
+    static size_t AllocateFromRun(SizeClassRuns &sizeClass, Run *run, void **slots, size_t count)
+    {
+        bool wasEmpty = run->IsEmpty();
+        size_t allocated = run->Allocate(slots, count);
+        if (wasEmpty && allocated != 0) {
+            sizeClass.emptyRunsCount--;
+        }
+        return allocated;
+    }
+
+    /// @brief Returns @param count slots of one size class under one lock
+    void FreeSlots(size_t sizeClassIdx, void *const *slots, size_t count)
+    {
+        auto &sizeClass = sizeClasses_[sizeClassIdx];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+        std::lock_guard lock(sizeClass.lock);
+        for (size_t i = 0; i < count; i++) {
+            Run *run = Run::FromPtr(slots[i]);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            run->Free(slots[i]);                // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            if (run->IsEmpty()) {
+                sizeClass.emptyRunsCount++;
+            }
+        }
+        if (sizeClass.emptyRunsCount > policy_.spareRunsPerClass) {
+            ReleaseEmptyRunsUnlocked(sizeClass, policy_.spareRunsPerClass);
+        }
+    }
+
+    /// @brief Unmaps empty runs of the size class until only @param keep of them are left
+    static void ReleaseEmptyRunsUnlocked(SizeClassRuns &sizeClass, size_t keep)
+    {
+        Run **link = &sizeClass.runs;
+        while (*link != nullptr && sizeClass.emptyRunsCount > keep) {
+            Run *run = *link;
+            if (!run->IsEmpty()) {
+                link = &run->next;
+                continue;
+            }
+            *link = run->next;
+            Run::Destroy(run);
+            sizeClass.runsCount--;
+            sizeClass.emptyRunsCount--;
+        }
+    }
+
+    RetentionPolicy policy_;
+    std::array<SizeClassRuns, SIZE_CLASSES_COUNT> sizeClasses_ {};
+    AllocatorCounters<> counters_;
+};
+
+/**
+ * Run of slots of one size. Header of the run keeps occupancy bitmap where set bit means free slot, so free slot is
+ * found with ctz over 64 slots at once and whole words are taken by batch allocation.
+ * Run is not thread-safe, it is protected by the lock of its size class.
+ */
+template <size_t ONE_MEM_POOL_SIZE, size_t... SLOTS_SIZES>
+template <size_t MEM_POOL_SIZE>
+class RunOfSlotsAllocator<ONE_MEM_POOL_SIZE, SLOTS_SIZES...>::RunOfSlotsMemoryPool {
+    static constexpr size_t BITS_IN_WORD = 64U;
+    // bit per slot of the smallest size class, runs of larger slots use the beginning of the bitmap
+    static constexpr size_t BITMAP_SIZE = (MEM_POOL_SIZE / MIN_SLOT_SIZE + BITS_IN_WORD - 1) / BITS_IN_WORD;
+    static constexpr size_t PAGE_SIZE = 4096U;
+
+public:
+    RunOfSlotsMemoryPool(size_t slotSize, size_t sizeClass)
+        : sizeClass_(sizeClass), slotSize_(slotSize), slotsCount_(MEM_POOL_SIZE / slotSize), freeCount_(slotsCount_)
+    {
+        for (size_t word = 0; word < slotsCount_ / BITS_IN_WORD; word++) {
+            freeBitmap_[word] = ~uint64_t(0);  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+        }
+        if (slotsCount_ % BITS_IN_WORD != 0) {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+            freeBitmap_[slotsCount_ / BITS_IN_WORD] = (uint64_t(1) << (slotsCount_ % BITS_IN_WORD)) - 1;
+        }
+    }
+    ~RunOfSlotsMemoryPool() = default;
+    NO_COPY_SEMANTIC(RunOfSlotsMemoryPool);
+    NO_MOVE_SEMANTIC(RunOfSlotsMemoryPool);
+
+    /// @brief Maps memory for a new run aligned by GetAlignment, only pages of the run stay mapped
+    static RunOfSlotsMemoryPool *Create(size_t slotSize, size_t sizeClass)
+    {
+        constexpr size_t ALIGNMENT = GetAlignment();
+        constexpr size_t MAP_SIZE = GetMapSize();
+        // mmap returns page aligned memory, so the aligned run always fits into this range
+        constexpr size_t RESERVE_SIZE = ALIGNMENT + MAP_SIZE - PAGE_SIZE;
+        void *raw = mmap(nullptr, RESERVE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED) {
+            return nullptr;
+        }
+        auto rawAddr = reinterpret_cast<uintptr_t>(raw);  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        uintptr_t addr = (rawAddr + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+        if (addr != rawAddr) {
+            munmap(raw, addr - rawAddr);
+        }
+        if (addr + MAP_SIZE != rawAddr + RESERVE_SIZE) {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast, performance-no-int-to-ptr)
+            munmap(reinterpret_cast<void *>(addr + MAP_SIZE), rawAddr + RESERVE_SIZE - (addr + MAP_SIZE));
+        }
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast, performance-no-int-to-ptr)
+        return new (reinterpret_cast<void *>(addr)) RunOfSlotsMemoryPool(slotSize, sizeClass);
+    }
+
+    /// @brief Returns memory of the run to OS
+    static void Destroy(RunOfSlotsMemoryPool *run)
+    {
+        run->~RunOfSlotsMemoryPool();
+        munmap(run, GetMapSize());
+    }
+
+    /// @returns run which contains @param ptr, ptr should point to the slot of some run
+    static RunOfSlotsMemoryPool *FromPtr(void *ptr)
+    {
+        auto addr = reinterpret_cast<uintptr_t>(ptr);  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast, performance-no-int-to-ptr)
+        return reinterpret_cast<RunOfSlotsMemoryPool *>(addr & ~(GetAlignment() - 1));
+    }
+
+    /**
+     * @brief Takes up to @param count free slots
+     * @returns count of slots written to @param slots
+     */
+    size_t Allocate(void **slots, size_t count)
+    {
+        size_t allocated = 0;
+        // all words before the hint have no free slots
+        for (size_t words = GetBitmapWords(); allocated < count && firstFreeWord_ < words; firstFreeWord_++) {
+            uint64_t &word = freeBitmap_[firstFreeWord_];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+            while (word != 0 && allocated < count) {
+                size_t slot = firstFreeWord_ * BITS_IN_WORD + static_cast<size_t>(__builtin_ctzll(word));
+                word &= word - 1;  // clear the lowest set bit
+                // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                slots[allocated++] = &mem_[slot * slotSize_];
+            }
+            if (word != 0) {
+                break;
+            }
+        }
+        freeCount_ -= allocated;
+        return allocated;
+    }
+
+    void Free(void *ptr)
+    {
+        size_t offset = GetOffset(ptr);
+        assert(offset % slotSize_ == 0);
+        size_t slot = offset / slotSize_;
+        assert(!IsFree(slot));
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+        freeBitmap_[slot / BITS_IN_WORD] |= uint64_t(1) << (slot % BITS_IN_WORD);
+        freeCount_++;
+        firstFreeWord_ = std::min(firstFreeWord_, slot / BITS_IN_WORD);
+    }
+
+    /// @returns true if @param ptr points inside the run memory
+    bool Contains(void *ptr) const
+    {
+        auto addr = reinterpret_cast<uintptr_t>(ptr);        // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        auto begin = reinterpret_cast<uintptr_t>(mem_.data());  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        return addr >= begin && addr < begin + slotsCount_ * slotSize_;
+    }
+
+    /// @returns true if @param ptr points to the begin of an allocated slot
+    bool VerifyPtr(void *ptr) const
+    {
+        size_t offset = GetOffset(ptr);
+        return offset % slotSize_ == 0 && !IsFree(offset / slotSize_);
+    }
+
+    /// @returns true if no slot of the run is allocated
+    bool IsEmpty() const
+    {
+        return freeCount_ == slotsCount_;
+    }
+
+    /// @returns true if all slots of the run are allocated
+    bool IsFull() const
+    {
+        return freeCount_ == 0;
+    }
+
+    size_t GetFreeSlotsCount() const
+    {
+        return freeCount_;
+    }
+
+    size_t GetSlotsCount() const
+    {
+        return slotsCount_;
+    }
+
+    size_t GetSizeClass() const
+    {
+        return sizeClass_;
+    }
+
+    /// @returns size of the mapping for one run, the run rounded up to pages
+    static constexpr size_t GetMapSize()
+    {
+        return (sizeof(RunOfSlotsMemoryPool) + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
+    }
+
+    /**
+     * @returns alignment of runs, it is a power of two not less than the run size, so run of a slot is found by
+     * masking the address. Address space between runs is not mapped.
+     */
+    static constexpr size_t GetAlignment()
+    {
+        size_t alignment = PAGE_SIZE;
+        while (alignment < sizeof(RunOfSlotsMemoryPool)) {
+            alignment *= 2U;
+        }
+        return alignment;
+    }
+
+    RunOfSlotsMemoryPool *next {nullptr};  // NOLINT(misc-non-private-member-variables-in-classes)
+
+private:
+    /// @returns count of the bitmap words which are used by the slots of the run, the rest is not initialized
+    size_t GetBitmapWords() const
+    {
+        return (slotsCount_ + BITS_IN_WORD - 1) / BITS_IN_WORD;
+    }
+
+    bool IsFree(size_t slot) const
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+        return (freeBitmap_[slot / BITS_IN_WORD] & (uint64_t(1) << (slot % BITS_IN_WORD))) != 0;
+    }
+
+    size_t GetOffset(void *ptr) const
+    {
+        return static_cast<size_t>(static_cast<uint8_t *>(ptr) - mem_.data());
+    }
+
+    size_t sizeClass_;
+    size_t slotSize_;
+    size_t slotsCount_;
+    size_t freeCount_;
+    size_t firstFreeWord_ {0};
+    // are not value-initialized, so pages of the run are committed by the first touch
+    std::array<uint64_t, BITMAP_SIZE> freeBitmap_;
+    alignas(std::max_align_t) std::array<uint8_t, MEM_POOL_SIZE> mem_;
+};
+
+/**
+ * Per-thread cache of free slots. Each thread should own its cache: slots are taken from the shared runs and
+ * returned back in batches, so common Allocate/Free pair does not touch shared state.
+ * A slot can be freed to any cache or to the allocator, not only to the one it was allocated from.
+ * Slots which are kept in caches are still reported as allocated by VerifyPtr.
+ */
+template <size_t ONE_MEM_POOL_SIZE, size_t... SLOTS_SIZES>
+class RunOfSlotsAllocator<ONE_MEM_POOL_SIZE, SLOTS_SIZES...>::ThreadCache {
+public:
+    static constexpr size_t CACHE_CAPACITY = 64U;
+    static constexpr size_t BATCH_SIZE = CACHE_CAPACITY / 2U;
+
+    explicit ThreadCache(RunOfSlotsAllocator &allocator) : allocator_(allocator) {}
+    ~ThreadCache()
+    {
+        for (size_t i = 0; i < SIZE_CLASSES_COUNT; i++) {
+            Flush(i, caches_[i].count);  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+        }
+        counters_.FlushTo(&allocator_.counters_);
+    }
+    NO_COPY_SEMANTIC(ThreadCache);
+    NO_MOVE_SEMANTIC(ThreadCache);
+
+    template <class T = uint8_t>
+    T *Allocate()
+    {
+        constexpr size_t SIZE_CLASS = GetSizeClass(sizeof(T));
+        if constexpr (SIZE_CLASS == SIZE_CLASSES_COUNT) {
+            counters_.OnAllocate(false);
+            return nullptr;
+        } else {
+            return static_cast<T *>(AllocateFromSizeClass(SIZE_CLASS, sizeof(T)));
+        }
+    }
+
+    void *Allocate(size_t size)
+    {
+        size_t sizeClass = GetSizeClass(size);
+        if (sizeClass == SIZE_CLASSES_COUNT) {
+            counters_.OnAllocate(false);
+            return nullptr;
+        }
+        return AllocateFromSizeClass(sizeClass, size);
+    }
+
+    /// @brief Caches the slot, @param ptr should be allocated by the same allocator
+    void Free(void *ptr)
+    {
+        if (ptr == nullptr) {
+            return;
+        }
+        // size class is read from the run header which is not changed after run creation
+        size_t sizeClass = Run::FromPtr(ptr)->GetSizeClass();
+        auto &cache = caches_[sizeClass];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+        if (UNLIKELY(cache.count == CACHE_CAPACITY)) {
+            Flush(sizeClass, BATCH_SIZE);
+        }
+        cache.slots[cache.count++] = ptr;  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+        counters_.OnFree();
+        TraceFree(ptr);
+    }
+
+private:
+    struct SizeClassCache {
+        std::array<void *, CACHE_CAPACITY> slots {};
+        size_t count {0};
+    };
+
+    /// @param size is the requested size, it is used for tracing only
+    void *AllocateFromSizeClass(size_t sizeClass, [[maybe_unused]] size_t size)
+    {
+        auto &cache = caches_[sizeClass];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+        if (UNLIKELY(cache.count == 0)) {
+            counters_.FlushTo(&allocator_.counters_);
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+            cache.count = allocator_.AllocateSlots(sizeClass, cache.slots.data(), BATCH_SIZE);
+            if (cache.count == 0) {
+                counters_.OnAllocate(false);
+                return nullptr;
+            }
+        }
+        counters_.OnAllocate(true);
+        void *slot = cache.slots[--cache.count];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+        TraceAllocate(slot, size, sizeClass);
+        return slot;
+    }
+
+    /// @brief Returns @param count the least recently freed slots of the size class to the shared run
+    void Flush(size_t sizeClass, size_t count)
+    {
+        auto &cache = caches_[sizeClass];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+        if (count == 0) {
+            return;
+        }
+        allocator_.FreeSlots(sizeClass, cache.slots.data(), count);
+        counters_.FlushTo(&allocator_.counters_);
+        for (size_t i = count; i < cache.count; i++) {
+            cache.slots[i - count] = cache.slots[i];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+        }
+        cache.count -= count;
+    }
+
+    RunOfSlotsAllocator &allocator_;
+    std::array<SizeClassCache, SIZE_CLASSES_COUNT> caches_ {};
+    LocalAllocatorCounters<> counters_;
 };
 
-#endif  // MEMORY_MANAGEMENT_RUN_OF_SLOTS_ALLOCATOR_INCLUDE_RUN_OF_SLOTS_ALLOCATOR_H
\ No newline at end of file
+#endif  // MEMORY_MANAGEMENT_RUN_OF_SLOTS_ALLOCATOR_INCLUDE_RUN_OF_SLOTS_ALLOCATOR_H
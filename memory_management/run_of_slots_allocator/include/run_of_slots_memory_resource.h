@@ -0,0 +1,57 @@
+#ifndef MEMORY_MANAGEMENT_RUN_OF_SLOTS_ALLOCATOR_INCLUDE_RUN_OF_SLOTS_MEMORY_RESOURCE_H
+#define MEMORY_MANAGEMENT_RUN_OF_SLOTS_ALLOCATOR_INCLUDE_RUN_OF_SLOTS_MEMORY_RESOURCE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include "base/macros.h"
+
+/**
+ * Memory resource over RunOfSlotsAllocator. It suits node-based containers whose nodes fit into the size classes,
+ * requests larger than the largest slot throw std::bad_alloc. Resource is thread-safe like the allocator.
+ */
+template <class SlotsAllocator>
+class RunOfSlotsMemoryResource final : public std::pmr::memory_resource {
+public:
+    explicit RunOfSlotsMemoryResource(SlotsAllocator &allocator) : allocator_(allocator) {}
+    ~RunOfSlotsMemoryResource() override = default;
+    NO_COPY_SEMANTIC(RunOfSlotsMemoryResource);
+    NO_MOVE_SEMANTIC(RunOfSlotsMemoryResource);
+
+    SlotsAllocator &GetAllocator() const
+    {
+        return allocator_;
+    }
+
+private:
+    void *do_allocate(size_t bytes, size_t alignment) override
+    {
+        void *mem = allocator_.Allocate(std::max<size_t>(bytes, 1U));
+        if (mem == nullptr) {
+            throw std::bad_alloc();
+        }
+        // slots are aligned by the lowest set bit of the slot size, it can be not enough for over-aligned types
+        auto addr = reinterpret_cast<uintptr_t>(mem);  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        if (UNLIKELY((addr & (alignment - 1)) != 0)) {
+            allocator_.Free(mem);
+            throw std::bad_alloc();
+        }
+        return mem;
+    }
+
+    void do_deallocate(void *ptr, [[maybe_unused]] size_t bytes, [[maybe_unused]] size_t alignment) override
+    {
+        allocator_.Free(ptr);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    SlotsAllocator &allocator_;
+};
+
+#endif  // MEMORY_MANAGEMENT_RUN_OF_SLOTS_ALLOCATOR_INCLUDE_RUN_OF_SLOTS_MEMORY_RESOURCE_H
@@ -1,9 +1,18 @@
 
 #include <gtest/gtest.h>
+#include <sys/mman.h>
 #include <cstddef>
+#include <list>
+#include <map>
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+#include "memory_management/common/include/stl_allocator.h"
 #include "memory_management/run_of_slots_allocator/include/run_of_slots_allocator.h"
+#include "memory_management/run_of_slots_allocator/include/run_of_slots_memory_resource.h"
 
-TEST(RunOfSlotsAllocatorTest, DISABLED_TemplateAllocationTest)  // remove DISABLED_ prefix to use test
+TEST(RunOfSlotsAllocatorTest, TemplateAllocationTest)
 {
     constexpr size_t MEMORY_POOL_SIZE = 2048U;
     RunOfSlotsAllocator<MEMORY_POOL_SIZE, 1U, 2U, 4U, 8U> allocator;
@@ -27,7 +36,7 @@ TEST(RunOfSlotsAllocatorTest, DISABLED_TemplateAllocationTest)  // remove DISABL
     allocator.Free(int1);
 }
 
-TEST(RunOfSlotsAllocatorTest, DISABLED_AllocatorMemPoolOverflowTest)  // remove DISABLED_ prefix to use test
+TEST(RunOfSlotsAllocatorTest, AllocatorMemPoolOverflowTest)
 {
     constexpr size_t MEMORY_POOL_SIZE = 8U;
     RunOfSlotsAllocator<MEMORY_POOL_SIZE, 1U, 2U, 4U, 8U> allocator;
@@ -46,4 +55,296 @@ TEST(RunOfSlotsAllocatorTest, DISABLED_AllocatorMemPoolOverflowTest)  // remove
 
     allocator.Free(mem);
     allocator.Free(memInt);
-}
\ No newline at end of file
+}
+
+TEST(RunOfSlotsAllocatorTest, ThreadCacheAllocationTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 2048U;
+    using Allocator = RunOfSlotsAllocator<MEMORY_POOL_SIZE, 4U, 8U>;
+    Allocator allocator;
+    {
+        Allocator::ThreadCache cache(allocator);
+        auto *first = cache.Allocate<size_t>();
+        ASSERT_NE(first, nullptr);
+        ASSERT_TRUE(allocator.VerifyPtr(first));
+        ASSERT_EQ(cache.Allocate<char[16U]>(), nullptr);  // there is no such size class
+
+        // freed slot is reused by the next allocation of the same size class
+        cache.Free(first);
+        ASSERT_EQ(cache.Allocate<size_t>(), first);
+
+        // slot from the shared runs can be freed to the cache and vice versa
+        auto *shared = allocator.Allocate<int>();
+        cache.Free(shared);
+        ASSERT_EQ(cache.Allocate<int>(), shared);
+        allocator.Free(shared);
+        ASSERT_FALSE(allocator.VerifyPtr(shared));
+        cache.Free(first);
+    }
+    // cache returns all its slots on destruction, so the whole run is available again
+    std::vector<size_t *> slots;
+    for (size_t i = 0; i < MEMORY_POOL_SIZE / sizeof(size_t); i++) {
+        slots.push_back(allocator.Allocate<size_t>());
+        ASSERT_NE(slots.back(), nullptr);
+    }
+    ASSERT_EQ(allocator.Allocate<size_t>(), nullptr);
+    for (auto *slot : slots) {
+        allocator.Free(slot);
+    }
+}
+
+TEST(RunOfSlotsAllocatorTest, ThreadCacheMultithreadingTest)
+{
+    constexpr size_t THREAD_COUNT = 8U;
+    constexpr size_t ALLOC_COUNT = 500U;
+    constexpr size_t MEMORY_POOL_SIZE = THREAD_COUNT * ALLOC_COUNT * sizeof(size_t);
+    using Allocator = RunOfSlotsAllocator<MEMORY_POOL_SIZE, 8U>;
+    auto allocator = std::make_unique<Allocator>();
+
+    std::vector<std::vector<size_t *>> allocated(THREAD_COUNT);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < THREAD_COUNT; i++) {
+        threads.emplace_back([&allocator, &ptrs = allocated[i], i]() {
+            Allocator::ThreadCache cache(*allocator);
+            for (size_t j = 0; j < ALLOC_COUNT; j++) {
+                auto *mem = cache.Allocate<size_t>();
+                ASSERT_NE(mem, nullptr);
+                *mem = i;
+                ptrs.push_back(mem);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    for (size_t i = 0; i < THREAD_COUNT; i++) {
+        for (auto *mem : allocated[i]) {
+            ASSERT_EQ(*mem, i);
+        }
+    }
+
+    // every thread frees slots allocated by its neighbour
+    threads.clear();
+    for (size_t i = 0; i < THREAD_COUNT; i++) {
+        threads.emplace_back([&allocator, &ptrs = allocated[(i + 1U) % THREAD_COUNT]]() {
+            Allocator::ThreadCache cache(*allocator);
+            for (auto *mem : ptrs) {
+                cache.Free(mem);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    for (size_t i = 0; i < THREAD_COUNT; i++) {
+        for (auto *mem : allocated[i]) {
+            ASSERT_FALSE(allocator->VerifyPtr(mem));
+        }
+    }
+}
+
+TEST(RunOfSlotsAllocatorTest, SizeClassDispatchTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 2048U;
+    // size classes are not sorted on purpose
+    using Allocator = RunOfSlotsAllocator<MEMORY_POOL_SIZE, 32U, 8U, 16U, 2000U>;
+    Allocator allocator;
+
+    auto *small = allocator.Allocate<uint16_t>();
+    auto *exact = allocator.Allocate(8U);
+    ASSERT_NE(small, nullptr);
+    ASSERT_NE(exact, nullptr);
+    ASSERT_EQ(size_t(exact) - size_t(small), 8U);  // both are in the class of 8 bytes
+
+    auto *medium = allocator.Allocate<char[12U]>();
+    auto *medium2 = allocator.Allocate(9U);
+    ASSERT_EQ(size_t(medium2) - size_t(medium), 16U);
+
+    // sizes above the table limit are resolved too
+    auto *large = allocator.Allocate(1500U);
+    ASSERT_NE(large, nullptr);
+    ASSERT_TRUE(allocator.VerifyPtr(large));
+    ASSERT_EQ(allocator.Allocate(2001U), nullptr);
+    ASSERT_EQ(allocator.Allocate<char[2001U]>(), nullptr);
+
+    Allocator::ThreadCache cache(allocator);
+    auto *cached = cache.Allocate(24U);
+    ASSERT_NE(cached, nullptr);
+    cache.Free(cached);
+    ASSERT_EQ(cache.Allocate<char[32U]>(), cached);
+    cache.Free(cached);
+
+    allocator.Free(small);
+    allocator.Free(exact);
+    allocator.Free(medium);
+    allocator.Free(medium2);
+    allocator.Free(large);
+}
+
+TEST(RunOfSlotsAllocatorTest, OccupancyBitmapTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 200U;  // is not multiple of bitmap word
+    RunOfSlotsAllocator<MEMORY_POOL_SIZE, 1U> allocator;
+
+    std::vector<char *> slots;
+    for (size_t i = 0; i < MEMORY_POOL_SIZE; i++) {
+        slots.push_back(allocator.Allocate<char>());
+        ASSERT_NE(slots.back(), nullptr);
+        ASSERT_EQ(size_t(slots.back()) - size_t(slots.front()), i);
+    }
+    ASSERT_EQ(allocator.Allocate<char>(), nullptr);
+
+    // the lowest free slot is reused first
+    constexpr size_t FIRST_FREED = 150U;
+    constexpr size_t SECOND_FREED = 70U;
+    allocator.Free(slots[FIRST_FREED]);
+    allocator.Free(slots[SECOND_FREED]);
+    ASSERT_FALSE(allocator.VerifyPtr(slots[FIRST_FREED]));
+    ASSERT_TRUE(allocator.VerifyPtr(slots[FIRST_FREED + 1U]));
+    ASSERT_EQ(allocator.Allocate<char>(), slots[SECOND_FREED]);
+    ASSERT_EQ(allocator.Allocate<char>(), slots[FIRST_FREED]);
+    ASSERT_EQ(allocator.Allocate<char>(), nullptr);
+
+    for (auto *slot : slots) {
+        allocator.Free(slot);
+    }
+    using Allocator = RunOfSlotsAllocator<MEMORY_POOL_SIZE, 1U>;
+    Allocator::ThreadCache cache(allocator);
+    ASSERT_EQ(cache.Allocate<char>(), slots[Allocator::ThreadCache::BATCH_SIZE - 1U]);
+}
+
+TEST(RunOfSlotsAllocatorTest, RunReclamationTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 64U;
+    constexpr size_t MAX_RUNS = 4U;
+    using Allocator = RunOfSlotsAllocator<MEMORY_POOL_SIZE, 8U>;
+    Allocator allocator(Allocator::RetentionPolicy {MAX_RUNS, 1U});
+    ASSERT_EQ(allocator.GetRunsCount(), 0U);
+
+    std::vector<size_t *> slots;
+    for (size_t i = 0; i < MAX_RUNS * MEMORY_POOL_SIZE / sizeof(size_t); i++) {
+        slots.push_back(allocator.Allocate<size_t>());
+        ASSERT_NE(slots.back(), nullptr);
+    }
+    ASSERT_EQ(allocator.GetRunsCount(), MAX_RUNS);
+    ASSERT_EQ(allocator.Allocate<size_t>(), nullptr);
+
+    // one empty run is kept as spare, the others are returned to OS
+    for (auto *slot : slots) {
+        allocator.Free(slot);
+    }
+    ASSERT_EQ(allocator.GetRunsCount(), 1U);
+    ASSERT_FALSE(allocator.VerifyPtr(slots.front()));
+
+    auto *mem = allocator.Allocate<size_t>();
+    ASSERT_NE(mem, nullptr);
+    ASSERT_EQ(allocator.GetRunsCount(), 1U);
+    allocator.Free(mem);
+
+    allocator.ReleaseEmptyRuns();
+    ASSERT_EQ(allocator.GetRunsCount(), 0U);
+    ASSERT_NE(allocator.Allocate<size_t>(), nullptr);
+}
+
+TEST(RunOfSlotsAllocatorTest, StatsTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 1024U;
+    RunOfSlotsAllocator<MEMORY_POOL_SIZE, 8U, 64U> allocator;
+
+    std::vector<void *> small;
+    for (size_t i = 0; i < 10U; i++) {
+        small.push_back(allocator.Allocate<uint64_t>());
+    }
+    void *large = allocator.Allocate(40U);
+    ASSERT_NE(large, nullptr);
+    ASSERT_EQ(allocator.Allocate(MEMORY_POOL_SIZE), nullptr);
+
+    auto stats = allocator.GetStats();
+    ASSERT_EQ(stats.sizeClasses.size(), 2U);
+    ASSERT_EQ(stats.sizeClasses[0].slotSize, 8U);
+    ASSERT_EQ(stats.sizeClasses[0].runsCount, 1U);
+    ASSERT_EQ(stats.sizeClasses[0].slotsCount, MEMORY_POOL_SIZE / 8U);
+    ASSERT_EQ(stats.sizeClasses[0].freeSlotsCount, MEMORY_POOL_SIZE / 8U - 10U);
+    ASSERT_EQ(stats.sizeClasses[1].freeSlotsCount, MEMORY_POOL_SIZE / 64U - 1U);
+    ASSERT_EQ(stats.bytesUsed, 10U * 8U + 64U);
+    ASSERT_EQ(stats.largestFreeBlock, 64U);
+    ASSERT_EQ(stats.freeBlocksCount, MEMORY_POOL_SIZE / 8U - 10U + MEMORY_POOL_SIZE / 64U - 1U);
+    ASSERT_EQ(stats.freeBlocksHistogram[3], MEMORY_POOL_SIZE / 8U - 10U);
+    ASSERT_EQ(stats.freeBlocksHistogram[6], MEMORY_POOL_SIZE / 64U - 1U);
+    ASSERT_GE(stats.bytesReserved, 2U * MEMORY_POOL_SIZE);
+    // only the pages of the runs are mapped, not the whole aligned range
+    ASSERT_LE(stats.bytesReserved, 2U * (MEMORY_POOL_SIZE + 4096U));
+
+    {
+        RunOfSlotsAllocator<MEMORY_POOL_SIZE, 8U, 64U>::ThreadCache cache(allocator);
+        cache.Free(cache.Allocate<uint64_t>());
+    }
+    for (void *ptr : small) {
+        allocator.Free(ptr);
+    }
+    allocator.Free(large);
+    stats = allocator.GetStats();
+    ASSERT_EQ(stats.bytesUsed, 0);
+    if constexpr (ALLOCATOR_COUNTERS_ENABLED) {
+        ASSERT_EQ(stats.allocationsCount, 12U);
+        ASSERT_EQ(stats.failedAllocationsCount, 1U);
+        ASSERT_EQ(stats.freesCount, 12U);
+    }
+}
+
+TEST(RunOfSlotsAllocatorTest, BitmapSizeTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 1024U * 1024U;
+    constexpr size_t SLOT_SIZE = 64U;
+    constexpr size_t PAGE_SIZE = 4096U;
+    RunOfSlotsAllocator<MEMORY_POOL_SIZE, SLOT_SIZE> allocator;
+    void *mem = allocator.Allocate(SLOT_SIZE);
+    ASSERT_NE(mem, nullptr);
+    // bitmap has a bit per slot, not per byte of the run
+    constexpr size_t BITMAP_BYTES = MEMORY_POOL_SIZE / SLOT_SIZE / 8U;
+    ASSERT_LE(allocator.GetStats().bytesReserved, MEMORY_POOL_SIZE + BITMAP_BYTES + PAGE_SIZE);
+
+    // pages of the slots are not touched until they are allocated
+    auto begin = reinterpret_cast<uintptr_t>(mem) & ~(PAGE_SIZE - 1U);  // NOLINT(*-reinterpret-cast)
+    std::vector<unsigned char> resident(MEMORY_POOL_SIZE / PAGE_SIZE);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast, performance-no-int-to-ptr)
+    ASSERT_EQ(mincore(reinterpret_cast<void *>(begin), MEMORY_POOL_SIZE - PAGE_SIZE, resident.data()), 0);
+    size_t residentPages = 0;
+    for (unsigned char page : resident) {
+        if ((page & 1U) != 0) {
+            residentPages++;
+        }
+    }
+    ASSERT_LE(residentPages, 2U);
+    allocator.Free(mem);
+}
+
+TEST(RunOfSlotsAllocatorTest, StlContainersTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 16U * 1024U;
+    using Allocator = RunOfSlotsAllocator<MEMORY_POOL_SIZE, 16U, 32U, 48U, 64U>;
+    using Resource = RunOfSlotsMemoryResource<Allocator>;
+    Allocator allocator;
+    Resource resource(allocator);
+
+    std::list<size_t, StlAllocator<size_t, Resource>> list {StlAllocator<size_t, Resource>(resource)};
+    std::map<size_t, size_t, std::less<>, StlAllocator<std::pair<const size_t, size_t>, Resource>> map {
+        StlAllocator<std::pair<const size_t, size_t>, Resource>(resource)};
+    constexpr size_t COUNT = 100U;
+    for (size_t i = 0; i < COUNT; i++) {
+        list.push_back(i);
+        map.emplace(i, i);
+    }
+    ASSERT_GT(allocator.GetStats().bytesUsed, COUNT * 2U * sizeof(size_t));
+    ASSERT_EQ(map.size(), COUNT);
+    ASSERT_EQ(map.rbegin()->second, COUNT - 1U);
+    list.clear();
+    map.clear();
+    ASSERT_EQ(allocator.GetStats().bytesUsed, 0);
+
+    std::pmr::set<int> set(&resource);
+    set.insert({3, 1, 2});
+    ASSERT_EQ(*set.begin(), 1);
+    // requests larger than the largest slot are not served
+    ASSERT_THROW((void)resource.allocate(MEMORY_POOL_SIZE), std::bad_alloc);
+}